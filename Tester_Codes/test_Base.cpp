@@ -3,6 +3,8 @@
 #include <vector>
 #include <string>
 #include <cassert>
+#include <algorithm>
+#include <cstdlib>
 
 class node
 {
@@ -94,11 +96,351 @@ void test_case_3()
 }
 
 
+void test_case_4()	//removing edges and nodes, reusing removed indices and compacting
+{
+	Base<int,int> d;
+	std::vector<int> v(6);
+	for(size_t i=0;i<6;i++)
+	{
+		v[i] = i;
+	}
+	d.add_node(v);
+	d.add_edge(v[0], v[1]);
+	d.add_edge(v[1], v[2]);
+	d.add_edge(v[2], v[3]);
+	d.add_edge(v[3], v[4]);
+	d.add_edge(v[4], v[5]);
+	d.add_edge(v[5], v[5]);	//self loop
+	assert(d.count_edge() == 6);
+
+	d.remove_edge(v[2], v[1]);	//undirected, so either direction removes it
+	assert(d.count_edge() == 5);
+	assert(d.bfs(v[0]).size() == 2);
+	d.remove_edge(v[1], v[2]);	//already removed
+	assert(d.count_edge() == 5);
+
+	d.remove_node(v[4]);
+	assert(d.count_node() == 5);
+	assert(d.count_edge() == 3);
+	assert(d.bfs(v[2]).size() == 2);
+
+	d.remove_node(v[5]);
+	assert(d.count_node() == 4);
+	assert(d.count_edge() == 2);
+
+	int extra = 10;
+	d.add_node(extra);		//takes the index of a removed node
+	assert(d.count_node() == 5);
+	d.add_edge(extra, v[0]);
+	assert(d.count_edge() == 3);
+	assert(d.bfs(extra).size() == 3);
+
+	d.compact();
+	assert(d.count_node() == 5);
+	assert(d.count_edge() == 3);
+	auto bfs_res = d.bfs(extra);
+	assert(bfs_res.size() == 3);
+	for(auto &x: bfs_res)
+	{
+		assert(x.node == 10 || x.node == 0 || x.node == 1);
+	}
+	assert(d.bfs(v[3]).size() == 2);
+
+	d.add_edge(v[3], v[1]);	//node indices after compaction still work through the labels
+	assert(d.bfs(v[2]).size() == 6 - 1);
+}
+
+
+void test_case_5()	//dense ids and labels give the same traversal
+{
+	Base<std::string,int> f;
+	std::vector<std::string> v(6);
+	for(size_t i=0;i<6;i++)
+	{
+		v[i] = "a fairly long label so that copying it is not free " + std::to_string(i);
+	}
+	f.add_node(v);
+	for(size_t i=0;i+1<6;i++)
+	{
+		f.add_edge(v[i], v[i+1]);
+	}
+	std::string missing = "missing";
+	assert(f.id(missing) == -1);
+	for(size_t i=0;i<6;i++)
+	{
+		assert(f.label(f.id(v[i])) == v[i]);
+	}
+
+	auto by_label = f.bfs(v[2]);
+	auto by_id = f.bfs_ids(v[2]);
+	assert(by_label.size() == 6 && by_id.size() == 6);
+	for(size_t k=0;k<by_id.size();k++)
+	{
+		assert(f.label(by_id[k].node) == by_label[k].node);
+		assert(f.label(by_id[k].parent) == by_label[k].parent);
+		assert(by_id[k].distance == by_label[k].distance);
+	}
+	assert(f.dfs_ids(v[0], 3).size() == f.dfs(v[0], 3).size());
+
+	f.remove_node(v[1]);
+	f.compact();
+	assert(f.id(v[0]) == 0 && f.id(v[2]) == 1);
+	assert(f.label(1) == v[2]);
+	assert(f.bfs_ids(v[2]).size() == 4);
+}
+
+
+void test_case_6()	//visitors and lazy ranges on a binary tree 0 - (1, 2), 1 - (3, 4), 2 - (5, 6)
+{
+	Base<int,int> g;
+	std::vector<int> v(7);
+	for(size_t i=0;i<7;i++)
+	{
+		v[i] = i;
+	}
+	g.add_node(v);
+	for(size_t i=1;i<7;i++)
+	{
+		g.add_edge(v[(i-1)/2], v[i], 10 + i);
+	}
+
+	std::vector<int> order;
+	bool stopped = g.bfs(v[0], [&](int &u, int &parent, int depth)
+		{
+			order.push_back(u);
+			return traversal_action::CONTINUE;
+		});
+	assert(stopped == false);
+	auto expected = g.bfs(v[0]);
+	assert(order.size() == expected.size());
+	for(size_t k=0;k<order.size();k++)
+	{
+		assert(order[k] == expected[k].node);
+	}
+
+	int seen = 0;
+	stopped = g.bfs(v[0], [&](int &u, int &parent, int depth)
+		{
+			seen += 1;
+			return u == 4 ? traversal_action::STOP : traversal_action::CONTINUE;
+		});
+	assert(stopped == true && seen == 5);
+
+	order.clear();
+	g.dfs(v[0], [&](int &u, int &parent, int depth)
+		{
+			order.push_back(u);
+			assert(depth == (u == 0 ? 0 : (u <= 2 ? 1 : 2)));
+			return u == 1 ? traversal_action::SKIP : traversal_action::CONTINUE;	//prune the subtree of 1
+		});
+	assert((order == std::vector<int>{0, 1, 2, 5, 6}));
+
+	int weight = 0;
+	g.bfs(v[0], [&](int &u, int &parent, int depth)
+		{
+			return traversal_action::CONTINUE;
+		},
+		[&](int &from, int &to, const int &edge)
+		{
+			weight += edge;
+			return to == 2 ? traversal_action::SKIP : traversal_action::CONTINUE;	//never go down to 2
+		});
+	assert(weight == 11 + 12 + 13 + 14 + 11 + 13 + 14);	//edges of 0, 1, and of 3 and 4 back to 1
+
+	order.clear();
+	for(auto &t : g.bfs_range(v[0]))
+	{
+		order.push_back(t.node);
+	}
+	auto ids = g.bfs_ids(v[0]);
+	assert(order.size() == ids.size());
+	for(size_t k=0;k<order.size();k++)
+	{
+		assert(order[k] == ids[k].node);
+	}
+
+	order.clear();
+	auto range = g.dfs_range(v[0]);
+	for(auto it = range.begin(); it != range.end(); ++it)
+	{
+		order.push_back(it->node);
+		if(it->node == 2)
+		{
+			range.skip();
+		}
+	}
+	assert((order == std::vector<int>{0, 1, 3, 4, 2}));
+
+	int count = 0;
+	for(auto &t : g.dfs_range(v[0], 2))
+	{
+		assert(t.distance <= 1);
+		count += 1;
+	}
+	assert(count == 3);
+
+	int missing = 0;	//equal to a label, but not a node
+	count = 0;
+	auto visit = [&](int&, int&, int)
+	{
+		count += 1;
+		return traversal_action::CONTINUE;
+	};
+	assert(g.bfs(missing, visit) == false && g.dfs(missing, visit) == false && count == 0);
+	auto none = g.bfs_range(missing);
+	assert((none.begin() != none.end()) == false);
+	for(auto &t : g.dfs_range(missing))
+	{
+		count += 1 + t.node;
+	}
+	assert(count == 0 && g.id(missing) == -1);
+
+	Base<int,int> empty;
+	assert(empty.bfs(missing, visit) == false && count == 0);
+	for(auto &t : empty.bfs_range(missing))
+	{
+		count += 1 + t.node;
+	}
+	assert(count == 0 && empty.id(missing) == -1);
+}
+
+
+void test_case_7()	//reorder keeps the graph the same and only moves the ids, a path inserted in random order
+{
+	const int n = 40;
+	std::vector<int> v(n), shuffled(n);
+	for(int i=0;i<n;i++)
+	{
+		v[i] = i;
+		shuffled[i] = (i * 17) % n;
+	}
+	auto bandwidth = [&](Base<int,int> &f)
+	{
+		int most = 0;
+		for(int i=0;i+1<n;i++)
+		{
+			most = std::max(most, std::abs(f.id(v[i]) - f.id(v[i+1])));
+		}
+		return most;
+	};
+
+	for(auto strategy : { reorder_strategy::DEGREE, reorder_strategy::BFS, reorder_strategy::RCM, reorder_strategy::GORDER })
+	{
+		Base<int,int> f;
+		for(int i=0;i<n;i++)
+		{
+			f.add_node(v[shuffled[i]]);
+		}
+		for(int i=0;i+1<n;i++)
+		{
+			f.add_edge(v[i], v[i+1], i);
+		}
+		f.add_node(v[0]);
+		int extra = n;
+		f.add_node(extra);
+		f.remove_node(extra);	//reorder compacts first
+
+		f.reorder(strategy);
+		assert(f.count_node() == n && f.count_edge() == n - 1);
+		for(auto &t : f.bfs(v[0]))
+		{
+			assert(t.distance == t.node && (t.node == 0 || t.parent == t.node - 1));
+		}
+		f.bfs(v[0], [](int&, int&, int)
+			{
+				return traversal_action::CONTINUE;
+			},
+			[](int &x, int &y, const int &ed)
+			{
+				assert(ed == std::min(x, y));	//every edge still carries its own payload
+				return traversal_action::CONTINUE;
+			});
+
+		if(strategy == reorder_strategy::DEGREE)
+		{
+			assert(f.id(v[0]) >= n - 2 && f.id(v[n-1]) >= n - 2);	//the two ends have the lowest degree
+		}
+		if(strategy == reorder_strategy::RCM)
+		{
+			assert(bandwidth(f) == 1);
+		}
+		if(strategy == reorder_strategy::BFS)
+		{
+			assert(bandwidth(f) <= 2);
+		}
+		if(strategy == reorder_strategy::GORDER)	//no bound on the longest edge, but nearly every edge joins consecutive ids
+		{
+			int consecutive = 0;
+			for(int i=0;i+1<n;i++)
+			{
+				consecutive += (std::abs(f.id(v[i]) - f.id(v[i+1])) == 1);
+			}
+			assert(consecutive >= n - 6);
+		}
+	}
+
+	graph<int,true> g;	//a reachability index built before the reorder must not be used after it
+	g.add_node(v);
+	for(int i=0;i+1<n;i++)
+	{
+		g.add_edge(v[shuffled[i]], v[shuffled[i+1]]);
+	}
+	assert(g.reachable(v[shuffled[0]], v[shuffled[n-1]]) == true);
+	g.reorder(reorder_strategy::GORDER);
+	for(int i=0;i<n;i+=3)
+	{
+		for(int j=0;j<n;j+=5)
+		{
+			assert(g.reachable(v[shuffled[i]], v[shuffled[j]]) == (i <= j));
+		}
+	}
+}
+
+
+void test_case_8()	//label() of a graph built with add_node round trips through id and the traversals
+{
+	graph<int,false> g;
+	std::vector<int> v(60);
+	for(int i=0;i<60;i++)
+	{
+		v[i] = i;
+		g.add_node(v[i]);	//the node vector grows and moves many times
+	}
+	for(int i=0;i+1<60;i++)
+	{
+		g.add_edge(v[i], v[i+1]);
+	}
+	for(int i=0;i<60;i++)
+	{
+		assert(g.id(g.label(i)) == i && g.id(v[i]) == i);
+	}
+	assert(g.bfs(g.label(0)).size() == 60);
+	g.remove_node(g.label(30));
+	assert(g.id(v[30]) == -1 && g.bfs(v[0]).size() == 30);
+	int extra = 100;
+	g.add_node(extra);	//takes the slot of 30
+	assert(g.id(g.label(30)) == 30 && g.label(30) == 100);
+	g.add_edge(g.label(30), v[29]);
+	g.compact();
+	g.reorder(reorder_strategy::RCM);
+	for(int i=0;i<60;i++)
+	{
+		assert(g.id(g.label(i)) == i);
+	}
+	assert(g.bfs(g.label(g.id(v[0]))).size() == 31);
+}
+
+
 void run_test()
 {
 	test_case_1();
 	test_case_2();
 	test_case_3();
+	test_case_4();
+	test_case_5();
+	test_case_6();
+	test_case_7();
+	test_case_8();
 }
 
 int main()
@@ -310,11 +310,296 @@ void test_case_3()  //Example from Introduction to Algorithms by Cormen
 
 }
 
+void test_case_4()  //condensation of the graph from Gabow's Paper
+{
+    graph<int, true, true, int> G;
+    std::vector<int> v(6);
+
+    for (int i = 0; i < 6; i++)
+    {
+        v[i] = i + 1;
+    }
+
+    G.add_node(v);
+
+    G.add_edge(v[0], v[1], 5);
+    G.add_edge(v[0], v[2], 1);
+    G.add_edge(v[1], v[2], 4);
+    G.add_edge(v[1], v[3], 1);
+    G.add_edge(v[3], v[2], 2);
+    G.add_edge(v[3], v[4], 1);
+    G.add_edge(v[4], v[1], 1);
+    G.add_edge(v[4], v[5], 1);
+    G.add_edge(v[5], v[3], 1);
+    G.add_edge(v[5], v[2], 3);
+    assert(G.count_edge() == 10);
+
+    auto [C, component] = G.condensation();
+
+    assert(component.size() == 6);
+    assert(C.count_node() == 3);
+    assert(C.count_edge() == 3);    // {1} -> {2,4,5,6}, {1} -> {3}, {2,4,5,6} -> {3}
+
+    assert(component[1] == component[3]);
+    assert(component[1] == component[4]);
+    assert(component[1] == component[5]);
+    assert(component[0] != component[1]);
+    assert(component[0] != component[2]);
+    assert(component[1] != component[2]);
+
+    //component ids are in reverse topological order
+    assert(component[0] > component[1]);
+    assert(component[1] > component[2]);
+    assert(C.is_dag() == true);
+
+    std::function<int(int)> get_weight = [](int x)
+    {
+        return x;
+    };
+
+    auto minimum = G.condensation(get_weight, merge_policy::MIN);
+    auto total = G.condensation(get_weight, merge_policy::SUM);
+    auto count = G.condensation(get_weight, merge_policy::COUNT);
+
+    assert(minimum.dag.count_edge() == 3);
+    assert(total.dag.count_edge() == 3);
+    assert(count.dag.count_edge() == 3);
+
+    std::function<int64_t(int64_t)> identity = [](int64_t x)
+    {
+        return x;
+    };
+
+    //edges between the components are read back through all pair shortest path, since it needs no source node
+    auto weight_between = [&](auto &H, int from, int to)
+    {
+        for (auto &x : H.all_pair_shortest_path(identity))
+        {
+            if (x.from == from && x.to == to)
+            {
+                return x.distance;
+            }
+        }
+        return int64_t(-1);
+    };
+
+    int single = component[0], big = component[1], sink = component[2];
+
+    //edges from the big component to {3} are 4, 2 and 3
+    assert(weight_between(minimum.dag, big, sink) == 2);
+    assert(weight_between(total.dag, big, sink) == 9);
+    assert(weight_between(count.dag, big, sink) == 3);
+
+    assert(weight_between(minimum.dag, single, big) == 5);
+    assert(weight_between(total.dag, single, sink) == 1);
+    assert(weight_between(count.dag, single, sink) == 1);
+}
+
+void test_case_5()  //incoming edges
+{
+    graph<int, true> G;
+    std::vector<int> v(5);
+
+    for (int i = 0; i < 5; i++)
+    {
+        v[i] = i;
+    }
+
+    G.add_node(v);
+    G.add_edge(v[0], v[2]);
+    G.add_edge(v[1], v[2]);
+    G.add_edge(v[2], v[3]);
+
+    assert(G.in_degree(v[2]) == 2);     //reverse adjacency is built here
+    assert(G.in_degree(v[0]) == 0);
+
+    auto pred = G.predecessors(v[2]);
+    sort(pred.begin(), pred.end());
+    assert(pred.size() == 2);
+    assert(pred[0] == 0);
+    assert(pred[1] == 1);
+
+    G.add_edge(v[4], v[2]);             //and kept in sync from now on
+    G.add_edge(v[3], v[0]);
+    assert(G.in_degree(v[2]) == 3);
+    assert(G.in_degree(v[0]) == 1);
+    assert(G.predecessors(v[0])[0] == 3);
+
+    int extra = 5;
+    G.add_node(extra);
+    G.add_edge(v[0], extra);
+    assert(G.in_degree(extra) == 1);
+    assert(G.predecessors(extra)[0] == 0);
+    assert(G.predecessors(v[4]).empty() == true);
+}
+
+void test_case_6()  //weakly connected components ignore the direction of the edges
+{
+    graph<int, true> G;
+    std::vector<int> v(7);
+
+    for (int i = 0; i < 7; i++)
+    {
+        v[i] = i;
+    }
+
+    G.add_node(v);
+    G.add_edge(v[1], v[0]);
+    G.add_edge(v[1], v[2]);
+    G.add_edge(v[4], v[3]);
+    G.add_edge(v[5], v[3]);
+
+    for (auto algorithm : { components_algorithm::UNION_FIND, components_algorithm::AFFOREST })
+    {
+        auto component = G.weakly_connected_components(algorithm, 3);
+        std::vector<int> expected = { 0, 0, 0, 1, 1, 1, 2 };
+        assert(component == expected);
+    }
+}
+
+void test_case_7()  //removed nodes are skipped by every algorithm, with and without the reverse adjacency
+{
+    for (bool with_reverse : { false, true })
+    {
+        graph<int, true> G;
+        std::vector<int> v(6);
+
+        for (int i = 0; i < 6; i++)
+        {
+            v[i] = i;
+        }
+
+        G.add_node(v);
+        if (with_reverse == true)
+        {
+            G.enable_reverse_adjacency();
+        }
+        G.add_edge(v[0], v[1]);
+        G.add_edge(v[1], v[2]);
+        G.add_edge(v[2], v[0]);
+        G.add_edge(v[2], v[3]);
+        G.add_edge(v[3], v[4]);
+        G.add_edge(v[4], v[3]);
+        G.add_edge(v[5], v[3]);
+        G.add_edge(v[3], v[3]);
+
+        assert(G.is_dag() == false);
+        assert(G.scc().size() == 3);
+
+        G.remove_node(v[3]);     //breaks the cycle {3, 4}
+        assert(G.count_node() == 5);
+        assert(G.count_edge() == 3);
+        assert(G.in_degree(v[4]) == 0);
+
+        auto scc = G.scc();
+        sort_for_checking(scc);
+        assert(scc.size() == 3);
+        assert(scc[0].size() == 1 && scc[1].size() == 1);
+        assert(scc[2].size() == 3);
+
+        G.remove_edge(v[2], v[0]);
+        assert(G.count_edge() == 2);
+        assert(G.is_dag() == true);
+        assert(G.topo_sort().size() == 5);
+        assert(G.reachable(v[0], v[2]) == true);
+        assert(G.reachable(v[2], v[0]) == false);
+
+        auto component = G.weakly_connected_components();
+        assert(component[3] == -1);
+
+        G.compact();
+        assert(G.count_node() == 5);
+        assert(G.count_edge() == 2);
+        assert(G.topo_sort().size() == 5);
+        assert(G.weakly_connected_components().size() == 5);
+        assert(G.predecessors(v[2]).size() == 1);
+        assert(G.predecessors(v[2])[0] == 1);
+
+        auto [C, to_component] = G.condensation();
+        assert(C.count_node() == 5);
+        assert(C.count_edge() == 2);
+    }
+}
+
+void test_case_8()  //dense ids, and labels which live inside the graph itself
+{
+    graph<int, true> G;
+    std::vector<int> v(6);
+
+    for (int i = 0; i < 6; i++)
+    {
+        v[i] = i + 1;
+    }
+    G.add_node(v);
+
+    G.add_edge(v[0], v[1]);
+    G.add_edge(v[0], v[2]);
+    G.add_edge(v[1], v[2]);
+    G.add_edge(v[1], v[3]);
+    G.add_edge(v[3], v[2]);
+    G.add_edge(v[3], v[4]);
+    G.add_edge(v[4], v[1]);
+    G.add_edge(v[4], v[5]);
+    G.add_edge(v[5], v[3]);
+    G.add_edge(v[5], v[2]);
+
+    auto by_label = G.scc();
+    auto by_id = G.scc_ids();
+    assert(by_label.size() == by_id.size());
+    for (size_t c = 0; c < by_id.size(); c++)
+    {
+        assert(by_label[c].size() == by_id[c].size());
+        for (size_t k = 0; k < by_id[c].size(); k++)
+        {
+            assert(G.label(by_id[c][k]) == by_label[c][k]);
+        }
+    }
+
+    assert(G.topo_sort_ids().empty() == true);  //there is a cycle
+
+    //the labels of a condensation are stored inside it, so they must survive the storage growing and compacting
+    auto [C, component] = G.condensation();
+    int source = component[0];
+    auto order = C.topo_sort_ids();
+    auto labels = C.topo_sort();
+    assert(order.size() == 3 && order[0] == source);
+    for (size_t k = 0; k < order.size(); k++)
+    {
+        assert(C.label(order[k]) == labels[k]);
+    }
+    assert(C.bfs(C.label(source)).size() == 3);
+
+    std::vector<int> more(100);
+    for (int i = 0; i < 100; i++)
+    {
+        more[i] = 100 + i;
+    }
+    C.add_node(more);
+    C.add_edge(C.label(component[2]), more[0]);
+    assert(C.bfs(C.label(source)).size() == 4);
+    assert(C.count_node() == 103);
+
+    C.remove_node(C.label(component[1]));
+    C.compact();
+    assert(C.count_node() == 102);
+    int found = 0;
+    for (int c = 0; c < 2; c++)
+    {
+        found += C.bfs(C.label(c)).size();
+    }
+    assert(found == 2 + 3);     //the source reaches the sink and more[0], the sink only more[0]
+}
+
 void run_test()
 {
     test_case_1();
     test_case_2();
     test_case_3();
+    test_case_4();
+    test_case_5();
+    test_case_6();
+    test_case_7();
+    test_case_8();
 }
 
 int main()
@@ -2,6 +2,7 @@
 #include <cassert> //for using assert staements for checking
 #include <cmath> //for using fabs function to find absolute value
 #include <vector>
+#include <random>
 
 #define EPS 1e-7 //the tolerance value in comparison of floating point values
 
@@ -373,11 +374,200 @@ void test_case_3() //Floating point and negative weight Example from Algorithms
 }
 
 
+void test_case_4() //bigger random graph, large enough for Krushkal to partition the edges instead of sorting them at once
+{
+	const int n = 400;
+	std::mt19937 random_generator(7);
+	graph<int, false, true, int> G;
+	std::vector<int> v(n);
+
+	for (int i = 0; i < n; i++)
+	{
+		v[i] = i;
+	}
+	G.add_node(v);
+
+	for (int i = 1; i < n; i++)	//a spanning path keeps the graph connected
+	{
+		G.add_edge(v[i - 1], v[i], 1000 + random_generator() % 1000);
+	}
+	for (int k = 0; k < 6000; k++)
+	{
+		int a = random_generator() % n, b = random_generator() % n;
+		if (a != b)
+		{
+			G.add_edge(v[a], v[b], random_generator() % 50);	//many equal weights
+		}
+	}
+
+	auto kruskal = G.krushkal_minimum_spanning_tree<int>(get_weight_1);
+	auto prims = G.prims_minimum_spanning_tree<int>(get_weight_1);
+	auto boruvka = G.boruvka_minimum_spanning_tree<int>(get_weight_1, 4);
+
+	assert(kruskal.first == prims.first);
+	assert(kruskal.first == boruvka.first);
+	assert(kruskal.second.size() == n - 1);
+	assert(boruvka.second.size() == n - 1);
+
+	int64_t total = 0;
+	for (auto &x : kruskal.second)
+	{
+		total += x.edge;
+	}
+	assert(total == kruskal.first);
+
+	G.remove_node(v[0]);	//the ends of the path, the rest stays connected, the tree counts only live nodes
+	G.remove_node(v[1]);
+	G.remove_node(v[n - 1]);
+	kruskal = G.krushkal_minimum_spanning_tree<int>(get_weight_1);
+	assert(kruskal.first == G.prims_minimum_spanning_tree<int>(get_weight_1).first);
+	assert(kruskal.second.size() == n - 4);
+}
+
+
+void test_case_5() //disconnected graph, every algorithm must return a minimum spanning forest
+{
+	graph<int, false, true, int> G;
+	std::vector<int> v(7);
+
+	for (int i = 0; i < 7; i++)
+	{
+		v[i] = i;
+	}
+	G.add_node(v);
+
+	G.add_edge(v[0], v[1], 3);
+	G.add_edge(v[1], v[2], 1);
+	G.add_edge(v[0], v[2], 2);
+
+	G.add_edge(v[3], v[4], 5);
+	G.add_edge(v[4], v[5], 5);
+	G.add_edge(v[3], v[5], 5);	//equal weights, one of them must be left out
+
+	//node 6 is isolated
+
+	auto kruskal = G.krushkal_minimum_spanning_tree<int>(get_weight_1);
+	auto prims = G.prims_minimum_spanning_tree<int>(get_weight_1);
+	auto boruvka = G.boruvka_minimum_spanning_tree<int>(get_weight_1);
+
+	assert(kruskal.first == 13);
+	assert(prims.first == 13);
+	assert(boruvka.first == 13);
+
+	assert(kruskal.second.size() == 4);
+	assert(prims.second.size() == 4);
+	assert(boruvka.second.size() == 4);
+}
+
+
+void test_case_6() //complete graph, where Prims switches to the array based version
+{
+	const int n = 60;
+	std::mt19937 random_generator(11);
+	graph<int, false, true, int> G;
+	std::vector<int> v(n);
+
+	for (int i = 0; i < n; i++)
+	{
+		v[i] = i;
+	}
+	G.add_node(v);
+
+	for (int i = 0; i < n; i++)
+	{
+		for (int j = i + 1; j < n; j++)
+		{
+			G.add_edge(v[i], v[j], random_generator() % 100);
+		}
+	}
+
+	auto kruskal = G.krushkal_minimum_spanning_tree<int>(get_weight_1);
+	auto prims = G.prims_minimum_spanning_tree<int>(get_weight_1);
+
+	assert(kruskal.first == prims.first);
+	assert(prims.second.size() == n - 1);
+
+	int64_t total = 0;
+	for (auto &x : prims.second)
+	{
+		total += x.edge;
+	}
+	assert(total == prims.first);
+
+	//no edges at all, weights come from the distance between points on a line, so the tree is the sorted path
+
+	graph<double, false, true, double> H;
+	std::vector<double> points = { 4.5, -2.0, 10.0, 0.5, 7.25 };
+	H.add_node(points);
+
+	std::function<double(double&, double&)> distance = [](double &a, double &b)
+	{
+		return fabs(a - b);
+	};
+
+	auto line = H.dense_prims_minimum_spanning_tree(distance);
+
+	assert(fabsl(line.first - 12.0l) < EPS);
+	assert(line.second.size() == 4);
+	for (auto &x : line.second)
+	{
+		assert(fabs(fabs(x.u - x.v) - x.edge) < EPS);
+	}
+}
+
+
+void test_case_7() //connected components, ids are dense and numbered by the smallest node in each component
+{
+	const int n = 2000;
+	std::mt19937 random_generator(3);
+	graph<int, false> G;
+	std::vector<int> v(n);
+
+	for (int i = 0; i < n; i++)
+	{
+		v[i] = i;
+	}
+	G.add_node(v);
+
+	for (int k = 0; k < 1900; k++)	//sparse enough to leave many components
+	{
+		int a = random_generator() % n, b = random_generator() % n;
+		G.add_edge(v[a], v[b]);
+	}
+
+	auto sequential = G.connected_components();
+	auto parallel = G.connected_components(components_algorithm::AFFOREST, 4);
+
+	assert(sequential.size() == n);
+	assert(sequential == parallel);
+	assert(sequential[0] == 0);
+
+	int next_id = 0;
+	for (int i = 0; i < n; i++)
+	{
+		assert(sequential[i] <= next_id);
+		if (sequential[i] == next_id)
+		{
+			next_id += 1;
+		}
+		for (auto &x : G.bfs(v[i]))	//everything reachable is in the same component
+		{
+			assert(sequential[x.node] == sequential[i]);
+		}
+	}
+	assert(next_id > 1);
+}
+
+
 void run_test_case()
 {
 	test_case_1();
 	test_case_2();
 	test_case_3();
+	test_case_4();
+	test_case_5();
+	test_case_6();
+	test_case_7();
 }
 
 int main()
@@ -185,7 +185,7 @@ void test_case_2()
                 return a.to < b.to;
              }
          });
-    const int pos_inf = 2e9;
+    const int pos_inf = std::numeric_limits<int>::max();   //unreachable
     int distance[5][5] = {
         {0,1,2,1,2},
         {2,0,1,3,1},
@@ -211,10 +211,73 @@ void test_case_2()
 
 }
 
+void test_case_3()  //E = void, no edge data is stored and add_edge takes only the two nodes
+{
+    graph<int, true, false, void> G;
+    graph<int, true> H;     //same graph with the default int edges
+    graph<int, false, false, void, pooled_storage<> > U;
+    std::vector<int> v(6);
+
+    for (size_t i = 0; i < 6; i++)
+    {
+        v[i] = i;
+    }
+    G.add_node(v);
+    H.add_node(v);
+    U.add_node(v);
+
+    int edges[7][2] = { {0, 1}, {1, 2}, {2, 0}, {2, 3}, {3, 4}, {4, 3}, {4, 5} };
+    for (auto &[a, b] : edges)
+    {
+        G.add_edge(v[a], v[b]);
+        H.add_edge(v[a], v[b]);
+        U.add_edge(v[a], v[b]);
+    }
+    G.add_edge(v[0], v[1]);     //already present, refused like any other duplicate
+    assert(G.count_edge() == 7);
+    assert(U.count_edge() == 6);    //4 -> 3 and 3 -> 4 are the same undirected edge
+
+    auto apsp_g = G.all_pair_shortest_path();
+    auto apsp_h = H.all_pair_shortest_path();
+    assert(apsp_g.size() == apsp_h.size());
+    for (size_t k = 0; k < apsp_g.size(); k++)
+    {
+        assert(apsp_g[k].from == apsp_h[k].from && apsp_g[k].to == apsp_h[k].to && apsp_g[k].distance == apsp_h[k].distance);
+    }
+    assert(G.scc().size() == 3);
+    assert(G.condensation().dag.count_edge() == 2);
+    assert(G.reachable(v[0], v[5]) == true && G.reachable(v[5], v[0]) == false);
+
+    size_t edges_seen = 0;
+    G.dfs(v[0], [](int&, int&, int)
+        {
+            return traversal_action::CONTINUE;
+        },
+        [&](int&, int&, const no_edge&)
+        {
+            edges_seen += 1;
+            return traversal_action::CONTINUE;
+        });
+    assert(edges_seen == 7);
+
+    G.remove_edge(v[2], v[0]);
+    G.remove_node(v[4]);
+    G.compact();
+    assert(G.count_edge() == 3 && G.is_dag() == true);
+
+    std::function<int(no_edge)> unit = [](no_edge)
+    {
+        return 1;
+    };
+    assert(U.krushkal_minimum_spanning_tree(unit).first == 5);
+    assert(U.connected_components() == std::vector<int>(6, 0));
+}
+
 void run_test_case()
 {
     test_case_1();
     test_case_2();
+    test_case_3();
 }
 
 int main()
@@ -2,6 +2,7 @@
 #include <cassert> //for using assert staements for checking
 #include <vector>
 #include <algorithm>
+#include <string>
 
 void test_case_1() //Example of non-negative Weight Edges from Introduction to Algorithms by Cormen , Fig 24.6
 {
@@ -312,12 +313,60 @@ void test_case_4() // Example from Algorithms by Robert Sedgewick and Kevin Wayn
 
 }
 
+void test_case_5() //dense ids give the same shortest paths as the labels
+{
+    graph<std::string, true, true, int> G;
+
+    std::vector<std::string> v(5);
+
+    for (size_t i = 0; i < 5; i++)
+    {
+        v[i] = "node number " + std::to_string(i);
+    }
+    G.add_node(v);
+
+    G.add_edge(v[0], v[1], 3);
+    G.add_edge(v[0], v[2], 8);
+    G.add_edge(v[0], v[4], 4);
+    G.add_edge(v[1], v[3], 1);
+    G.add_edge(v[1], v[4], 7);
+    G.add_edge(v[2], v[1], 4);
+    G.add_edge(v[3], v[2], 5);
+    G.add_edge(v[4], v[3], 6);
+
+    std::function<int(int)> get_weight = [](int x)
+    {
+        return x;
+    };
+
+    auto by_label = G.single_source_shortest_path(v[0], get_weight);
+    auto by_id = G.single_source_shortest_path_ids(v[0], get_weight);
+    assert(by_label.size() == 5 && by_id.size() == 5);
+    for (size_t k = 0; k < 5; k++)
+    {
+        assert(G.label(by_id[k].node) == by_label[k].node);
+        assert(G.label(by_id[k].parent) == by_label[k].parent);
+        assert(by_id[k].distance == by_label[k].distance);
+    }
+
+    auto all_by_label = G.all_pair_shortest_path(get_weight);
+    auto all_by_id = G.all_pair_shortest_path_ids(get_weight);
+    assert(all_by_label.size() == 25 && all_by_id.size() == 25);
+    for (size_t k = 0; k < 25; k++)
+    {
+        assert(G.label(all_by_id[k].from) == all_by_label[k].from);
+        assert(G.label(all_by_id[k].to) == all_by_label[k].to);
+        assert(all_by_id[k].distance == all_by_label[k].distance);
+    }
+}
+
 void run_test_case()
 {
     test_case_1();
     test_case_2();
     test_case_3();
     test_case_4();
+    test_case_5();
 }
 
 int main()
@@ -0,0 +1,261 @@
+#include "../source/graph_library.h"
+#include <cassert>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+
+
+void test_case_1()  //small_row alone, with strings so that every copy, move and destruction matters
+{
+    small_row<std::string, 2> row;
+    assert(row.empty() == true);
+    row.push_back("a");
+    row.push_back("b");     //still inline
+    row.push_back("c");     //moves to the arena
+    for (int i = 0; i < 20; i++)
+    {
+        row.push_back(std::to_string(i));
+    }
+    assert(row.size() == 23);
+    assert(row[0] == "a" && row[2] == "c" && row.back() == "19");
+
+    small_row<std::string, 2> copy(row);
+    small_row<std::string, 2> moved(std::move(row));
+    assert(row.empty() == true);
+    assert(copy.size() == 23 && moved.size() == 23);
+    for (size_t k = 0; k < copy.size(); k++)
+    {
+        assert(copy[k] == moved[k]);
+    }
+
+    while (moved.size() > 1)
+    {
+        moved.pop_back();
+    }
+    moved.shrink_to_fit();  //back inline
+    assert(moved.size() == 1 && moved[0] == "a");
+
+    moved.push_back(moved[0]);  //the argument lives inside the row itself
+    assert(moved[1] == "a");
+
+    row = copy;
+    copy.clear();
+    row.swap(copy);
+    assert(row.empty() == true && copy.size() == 23);
+
+    int count = 0;
+    for (auto &s : copy)
+    {
+        count += s.size();
+    }
+    assert(count == 3 + 10 + 20);
+}
+
+
+template<typename S>
+std::vector<std::vector<int> > distances(graph<int, false, true, int, S> &G, std::vector<int> &v)
+{
+    std::vector<std::vector<int> > ans;
+    for (auto &x : v)
+    {
+        std::vector<int> row(v.size(), -1);
+        for (auto &t : G.bfs(x))
+        {
+            row[t.node] = t.distance;
+        }
+        ans.push_back(row);
+    }
+    return ans;
+}
+
+
+void test_case_2()  //the pooled graph must behave exactly like the default one under additions, removals and compaction
+{
+    const int n = 200;
+    std::mt19937 random_generator(7);
+    graph<int, false, true, int> A;
+    graph<int, false, true, int, pooled_storage<> > B;
+    std::vector<int> v(n);
+
+    for (int i = 0; i < n; i++)
+    {
+        v[i] = i;
+    }
+    A.add_node(v);
+    B.add_node(v);
+
+    for (int k = 0; k < 3 * n; k++)
+    {
+        int a = random_generator() % n, b = random_generator() % n, w = random_generator() % 100;
+        if (k % 10 == 0)    //a few hubs so some rows go far past the inline capacity
+        {
+            a = random_generator() % 5;
+        }
+        if (a != b)
+        {
+            A.add_edge(v[a], v[b], w);
+            B.add_edge(v[a], v[b], w);
+        }
+    }
+    assert(A.count_edge() == B.count_edge());
+
+    std::function<int(int)> get_weight = [](int x)
+    {
+        return x;
+    };
+    assert(A.krushkal_minimum_spanning_tree(get_weight).first == B.krushkal_minimum_spanning_tree(get_weight).first);
+    assert(distances(A, v) == distances(B, v));
+
+    for (int k = 0; k < 20; k++)
+    {
+        int a = random_generator() % n;
+        A.remove_node(v[a]);
+        B.remove_node(v[a]);
+    }
+    assert(A.count_edge() == B.count_edge());
+    assert(A.connected_components() == B.connected_components());
+
+    A.compact();
+    B.compact();
+    assert(A.count_node() == B.count_node());
+    assert(A.prims_minimum_spanning_tree(get_weight).first == B.prims_minimum_spanning_tree(get_weight).first);
+}
+
+
+void test_case_3()  //directed graph with reverse adjacency, and reuse of the arena once a graph is gone
+{
+    const int n = 300;
+    std::vector<int> v(n);
+    for (int i = 0; i < n; i++)
+    {
+        v[i] = i;
+    }
+
+    auto &arena = row_arena<int>::instance();    //targets and int edges share the same arena
+    size_t reserved = 0;
+    for (int round = 0; round < 3; round++)
+    {
+        std::mt19937 random_generator(11);
+        graph<int, true, false, int, pooled_storage<1> > G;
+        graph<int, true> H;
+        G.add_node(v);
+        H.add_node(v);
+        G.enable_reverse_adjacency();
+        for (int k = 0; k < 4 * n; k++)
+        {
+            int a = random_generator() % 10, b = random_generator() % n;
+            G.add_edge(v[a], v[b]);
+            H.add_edge(v[a], v[b]);
+        }
+        for (int i = 0; i < n; i++)
+        {
+            assert(G.in_degree(v[i]) == H.in_degree(v[i]));
+        }
+        assert(G.scc().size() == H.scc().size());
+        assert(G.condensation().dag.count_edge() == H.condensation().dag.count_edge());
+
+        if (round == 0)
+        {
+            reserved = arena.reserved_bytes();
+        }
+        else    //the same shape of graph fits in the chunks released by the previous one
+        {
+            assert(arena.reserved_bytes() == reserved);
+        }
+    }
+}
+
+
+struct wide_edge    //a payload much larger than the target, which traversals must never need
+{
+    int from = 0, to = 0;
+    double weight = 0;
+    char note[16] = {};
+};
+
+
+void test_case_4()  //targets and edges are kept in separate rows, they must stay in step through removals and compaction
+{
+    const int n = 150;
+    std::mt19937 random_generator(5);
+    graph<int, false, true, wide_edge, pooled_storage<2> > G;
+    std::vector<int> v(n);
+    for (int i = 0; i < n; i++)
+    {
+        v[i] = i;
+    }
+    G.add_node(v);
+    for (int k = 0; k < 4 * n; k++)
+    {
+        int a = random_generator() % n, b = random_generator() % n;
+        if (a != b)
+        {
+            G.add_edge(v[a], v[b], wide_edge { std::min(a, b), std::max(a, b), double(a + b) });
+        }
+    }
+    for (int k = 0; k < 2 * n; k++)
+    {
+        int a = random_generator() % n, b = random_generator() % n;
+        G.remove_edge(v[a], v[b]);
+    }
+    for (int k = 0; k < 15; k++)
+    {
+        G.remove_node(v[random_generator() % n]);
+    }
+
+    auto check = [&]()
+    {
+        size_t edges = 0;
+        for (int i = 0; i < n; i++)
+        {
+            if (G.id(v[i]) == -1)
+            {
+                continue;
+            }
+            G.bfs(v[i], [](int&, int&, int depth)
+                {
+                    return depth == 0 ? traversal_action::CONTINUE : traversal_action::SKIP;   //only the edges of the source
+                },
+                [&](int &x, int &y, const wide_edge &ed)
+                {
+                    assert(ed.from == std::min(x, y) && ed.to == std::max(x, y) && ed.weight == x + y);
+                    edges += 1;
+                    return traversal_action::CONTINUE;
+                });
+        }
+        assert(edges == 2 * G.count_edge());
+    };
+    check();
+    G.compact();
+    check();
+
+    std::function<double(wide_edge)> get_weight = [](wide_edge ed)
+    {
+        return ed.weight;
+    };
+    auto [total, tree] = G.krushkal_minimum_spanning_tree(get_weight);
+    double sum = 0;
+    for (auto &x : tree)
+    {
+        assert(x.edge.weight == x.u + x.v);
+        sum += x.edge.weight;
+    }
+    assert(sum == total);
+}
+
+
+void run_test()
+{
+    test_case_1();
+    test_case_2();
+    test_case_3();
+    test_case_4();
+}
+
+int main()
+{
+    run_test();
+
+    return 0;
+}
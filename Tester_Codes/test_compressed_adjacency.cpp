@@ -0,0 +1,244 @@
+#include "../source/graph_library.h"
+#include <cassert>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+
+void test_case_1()  //rows must decode to exactly what was encoded, including empty rows, negative first gaps and gaps of many bytes
+{
+    std::mt19937 random_generator(3);
+    std::vector<std::vector<uint32_t> > rows(500);
+    for (size_t i = 0; i < rows.size(); i++)
+    {
+        int degree = (i % 7 == 0) ? 0 : random_generator() % 20;
+        for (int k = 0; k < degree; k++)
+        {
+            rows[i].push_back((k % 3 == 0) ? random_generator() : random_generator() % 1000);
+        }
+        std::sort(rows[i].begin(), rows[i].end());
+        rows[i].erase(std::unique(rows[i].begin(), rows[i].end()), rows[i].end());
+    }
+    rows[1] = { 0, 1, 4294967294u };    //first id below the row, and the largest gap an unsigned 32 bit id can have
+
+    compressed_adjacency<uint32_t, uint64_t> C;
+    C.build(rows);
+    assert(C.size() == rows.size());
+    for (size_t i = 0; i < rows.size(); i++)
+    {
+        std::vector<uint32_t> decoded;
+        for (uint32_t x : C[i])
+        {
+            decoded.push_back(x);
+        }
+        assert(C[i].size() == rows[i].size());
+        assert(decoded == rows[i]);
+    }
+}
+
+
+std::vector<std::vector<int> > canonical(std::vector<std::vector<int> > groups)  //component ids depend on the order of the rows, the partition does not
+{
+    for (auto &g : groups)
+    {
+        std::sort(g.begin(), g.end());
+    }
+    std::sort(groups.begin(), groups.end());
+    return groups;
+}
+
+
+void test_case_2()  //a frozen directed graph gives the same answers as the plain one and takes far less memory
+{
+    const int n = 2000;
+    std::mt19937 random_generator(17);
+    graph<int, true> G, H;
+    std::vector<int> v(n);
+    for (int i = 0; i < n; i++)
+    {
+        v[i] = i;
+    }
+    G.add_node(v);
+    H.add_node(v);
+    for (int k = 0; k < 6 * n; k++)
+    {
+        int a = random_generator() % n, b = (a + int(random_generator() % 64) - 16 + n) % n;   //mostly nearby ids, as after reorder
+        if (k % 50 == 0)
+        {
+            b = random_generator() % n;
+        }
+        G.add_edge(v[a], v[b]);
+        H.add_edge(v[a], v[b]);
+    }
+    size_t plain = G.adjacency_bytes();
+    G.freeze();
+    assert(G.frozen() == true);
+    assert(G.adjacency_bytes() * 3 < plain);
+    assert(G.count_edge() == H.count_edge());
+
+    for (int s = 0; s < n; s += 97)
+    {
+        auto a = G.bfs_ids(v[s]), b = H.bfs_ids(v[s]);
+        assert(a.size() == b.size());
+        std::vector<int> da(n, -1), db(n, -1);
+        for (size_t k = 0; k < a.size(); k++)
+        {
+            da[a[k].node] = a[k].distance;
+            db[b[k].node] = b[k].distance;
+        }
+        assert(da == db);
+        assert(G.dfs_ids(v[s]).size() == H.dfs_ids(v[s]).size());
+        assert(G.reachable(v[s], v[(s * 7) % n]) == H.reachable(v[s], v[(s * 7) % n]));
+    }
+    assert(canonical(G.scc_ids()) == canonical(H.scc_ids()));
+    assert(G.is_dag() == H.is_dag());
+    assert(G.weakly_connected_components() == H.weakly_connected_components());
+    assert(G.weakly_connected_components(components_algorithm::AFFOREST, 4) == H.weakly_connected_components());
+    for (int s = 0; s < n; s += 211)
+    {
+        std::vector<int> by_range, by_visitor;      //both follow the sorted rows, so they give the same order
+        for (auto &x : G.dfs_range(v[s]))
+        {
+            by_range.push_back(x.node);
+        }
+        G.dfs(v[s], [&](int &x, int&, int)
+            {
+                by_visitor.push_back(x);
+                return traversal_action::CONTINUE;
+            });
+        assert(by_range == by_visitor);
+        assert(by_range.size() == H.dfs_ids(v[s]).size());
+        size_t near_g = 0, near_h = 0;
+        for (auto &x : G.bfs_range(v[s], 3))
+        {
+            near_g += x.distance;
+        }
+        for (auto &x : H.bfs_range(v[s], 3))
+        {
+            near_h += x.distance;
+        }
+        assert(near_g == near_h);
+    }
+    assert(G.frozen() == true);     //nothing above needed more than the targets
+
+    graph<int, true> D;             //topological order needs a DAG
+    D.add_node(v);
+    for (int k = 0; k < 3 * n; k++)
+    {
+        int a = random_generator() % n, b = random_generator() % n;
+        if (a < b)
+        {
+            D.add_edge(v[a], v[b]);
+        }
+    }
+    D.freeze();
+    assert(D.is_dag() == true);
+    std::vector<int> position(n);
+    auto order = D.topo_sort_ids();
+    assert(order.size() == n);
+    for (int k = 0; k < n; k++)
+    {
+        position[order[k]] = k;
+    }
+    D.bfs(v[0], [](int&, int&, int)     //visitors read the compressed rows, D stays frozen
+        {
+            return traversal_action::CONTINUE;
+        },
+        [&](int &x, int &y, const int&)
+        {
+            assert(position[x] < position[y]);
+            return traversal_action::CONTINUE;
+        });
+    assert(D.frozen() == true);
+
+    G.add_edge(v[0], v[1]);         //thaws, the edge lookup is back so a duplicate is still refused
+    assert(G.frozen() == false);
+    H.add_edge(v[0], v[1]);
+    assert(G.count_edge() == H.count_edge());
+    assert(canonical(G.scc_ids()) == canonical(H.scc_ids()));
+    G.remove_node(v[5]);
+    H.remove_node(v[5]);
+    assert(G.count_edge() == H.count_edge());
+}
+
+
+void test_case_3()  //edges stay with their targets when the rows are sorted, through freeze and thaw
+{
+    const int n = 300;
+    std::mt19937 random_generator(23);
+    graph<int, false, true, int, pooled_storage<> > G;
+    graph<int, false, true, int> H;
+    std::vector<int> v(n);
+    for (int i = 0; i < n; i++)
+    {
+        v[i] = i;
+    }
+    G.add_node(v);
+    H.add_node(v);
+    for (int k = 0; k < 4 * n; k++)
+    {
+        int a = random_generator() % n, b = random_generator() % n;
+        if (a != b)
+        {
+            G.add_edge(v[a], v[b], a * b % 101);
+            H.add_edge(v[a], v[b], a * b % 101);
+        }
+    }
+    G.freeze();
+    assert(G.connected_components() == H.connected_components());
+    assert(G.count_edge() == H.count_edge());
+
+    std::function<int(int)> get_weight = [](int x)
+    {
+        return x;
+    };
+    auto a = G.single_source_shortest_path_ids(v[0], get_weight);  //thaws G
+    auto b = H.single_source_shortest_path_ids(v[0], get_weight);
+    std::vector<int64_t> da(n), db(n);
+    for (size_t k = 0; k < a.size(); k++)
+    {
+        da[a[k].node] = a[k].distance;
+        db[b[k].node] = b[k].distance;
+    }
+    assert(da == db);
+
+    G.freeze();
+    assert(G.krushkal_minimum_spanning_tree(get_weight).first == H.krushkal_minimum_spanning_tree(get_weight).first);
+    G.freeze();
+    assert(G.boruvka_minimum_spanning_tree(get_weight).first == H.prims_minimum_spanning_tree(get_weight).first);
+
+    G.freeze();
+    int64_t total_g = 0, total_h = 0;
+    auto visit = [](int&, int&, int)
+    {
+        return traversal_action::CONTINUE;
+    };
+    G.bfs(v[0], visit, [&](int &x, int &y, const int &w)    //the edge of the sorted row is read next to its target
+        {
+            assert(w == x * y % 101);
+            total_g += w;
+            return traversal_action::CONTINUE;
+        });
+    H.bfs(v[0], visit, [&](int&, int&, const int &w)
+        {
+            total_h += w;
+            return traversal_action::CONTINUE;
+        });
+    assert(total_g == total_h);
+    assert(G.frozen() == true);
+}
+
+
+void run_test()
+{
+    test_case_1();
+    test_case_2();
+    test_case_3();
+}
+
+int main()
+{
+    run_test();
+
+    return 0;
+}
@@ -1,5 +1,7 @@
 #include "../source/graph_library.h"
 #include <cassert>
+#include <thread>
+#include <vector>
 
 void test_case_1()
 {
@@ -173,11 +175,62 @@ void test_case_3()
 }
 
 
+void test_case_4()    //32 bit indices, and a chain deep enough to overflow the stack of a recursive find
+{
+    const uint32_t n = 1 << 21;
+    disjoint_set_union<uint32_t> DSU(n);
+    for (uint32_t i = 1; i < n; i++)
+    {
+        assert(DSU.do_union(i, i - 1) == true);
+    }
+    assert(DSU.do_union(0, n - 1) == false);
+    assert(DSU.find_size(n / 2) == n);
+    assert(DSU.is_same(0, n - 1) == true);
+}
+
+
+void test_case_5()    //many threads joining overlapping pairs at once
+{
+    const int n = 1 << 18, number_of_threads = 8;
+    concurrent_disjoint_set_union DSU(n);
+    std::atomic<int> successful_unions(0);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < number_of_threads; t++)
+    {
+        threads.emplace_back([&, t]()
+            {
+                for (int i = t; i + 2 < n; i += number_of_threads)
+                {
+                    if (DSU.do_union(i, i + 2) == true)    //even and odd nodes form two chains
+                    {
+                        successful_unions += 1;
+                    }
+                    DSU.do_union(i + 2, i);
+                }
+            });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    assert(successful_unions == n - 2);     //every union except the two roots
+    assert(DSU.is_same(0, n - 2) == true);
+    assert(DSU.is_same(1, n - 1) == true);
+    assert(DSU.is_same(0, 1) == false);
+    assert(DSU.find_parent(n - 2) == 0);    //larger index is always linked below the smaller one
+    assert(DSU.find_parent(n - 1) == 1);
+}
+
+
 void run_test()
 {
     test_case_1();
     test_case_2();
     test_case_3();
+    test_case_4();
+    test_case_5();
 }
 
 
@@ -0,0 +1,225 @@
+#include "../source/graph_library.h"
+#include <cassert>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+
+void write_file(const std::string &path, const std::string &text)
+{
+    std::ofstream(path, std::ios::binary) << text;
+}
+
+
+size_t number_of_components(std::vector<int> component)
+{
+    std::sort(component.begin(), component.end());
+    return std::unique(component.begin(), component.end()) - component.begin();
+}
+
+
+void test_case_1()  //SNAP file with comments, sparse ids, duplicates and weights, compared with add_edge
+{
+    const int n = 2000;
+    std::mt19937 random_generator(10);
+    std::string text = "# Directed graph\n# FromNodeId\tToNodeId\n";
+    std::vector<std::pair<int, int> > pairs;
+    std::vector<double> w;
+    for (int k = 0; k < 6 * n; k++)
+    {
+        int a = random_generator() % n, b = random_generator() % n;
+        pairs.push_back({ a * 7 + 3, b * 7 + 3 });
+        w.push_back((a * b % 89) / 8.0);
+        text += std::to_string(a * 7 + 3) + "\t" + std::to_string(b * 7 + 3) + " " + std::to_string(w.back()) + ((k % 5 == 0) ? "\r\n" : "\n");
+    }
+    write_file("test_edge_list_1.txt", text);
+
+    graph<int, true, true, double> G;
+    assert(G.read_edge_list("test_edge_list_1.txt", edge_list_format::SNAP, 4) == true);
+
+    graph<int, true, true, double> H;
+    std::vector<int> labels;
+    for (auto &[a, b] : pairs)
+    {
+        labels.push_back(a);
+        labels.push_back(b);
+    }
+    std::sort(labels.begin(), labels.end());
+    labels.erase(std::unique(labels.begin(), labels.end()), labels.end());
+    H.add_node(labels);
+    std::cout.setstate(std::ios::failbit);  //duplicates are reported by add_edge
+    for (size_t k = 0; k < pairs.size(); k++)
+    {
+        int a = std::lower_bound(labels.begin(), labels.end(), pairs[k].first) - labels.begin();
+        int b = std::lower_bound(labels.begin(), labels.end(), pairs[k].second) - labels.begin();
+        H.add_edge(labels[a], labels[b], w[k]);
+    }
+    std::cout.clear();
+
+    assert(G.count_node() == H.count_node() && G.count_edge() == H.count_edge());
+    for (int i = 0; i < int(labels.size()); i++)
+    {
+        assert(G.label(i) == labels[i]);     //ids are given in increasing order of the file's ids
+    }
+    std::function<double(double)> get_weight = [](double x)
+    {
+        return x;
+    };
+    for (int s = 0; s < int(labels.size()); s += 97)
+    {
+        auto a = G.single_source_shortest_path_ids(G.label(s), get_weight), b = H.single_source_shortest_path_ids(labels[s], get_weight);
+        std::vector<double> da(labels.size(), -1), db(labels.size(), -1);
+        for (size_t k = 0; k < a.size(); k++)
+        {
+            da[a[k].node] = a[k].distance;
+        }
+        for (size_t k = 0; k < b.size(); k++)
+        {
+            db[b[k].node] = b[k].distance;
+        }
+        assert(da == db);
+    }
+    assert(G.scc_ids().size() == H.scc_ids().size());
+    std::remove("test_edge_list_1.txt");
+}
+
+
+void test_case_2()  //Matrix Market, general and symmetric, pattern and real
+{
+    write_file("test_edge_list_2.mtx",
+        "%%MatrixMarket matrix coordinate pattern symmetric\n"
+        "% a comment\n"
+        "\n"
+        "5 5 5\n"
+        "2 1\n"
+        "3 1\n"
+        "3 3\n"
+        "5 4\n"
+        "   4 2   \n");
+    graph<int, false> U;
+    assert(U.read_edge_list("test_edge_list_2.mtx", edge_list_format::MATRIX_MARKET, 3) == true);
+    assert(U.count_node() == 5 && U.count_edge() == 5);
+    assert(number_of_components(U.connected_components()) == 1);
+
+    graph<int, true> D;     //a symmetric matrix read into a directed graph has both arcs
+    assert(D.read_edge_list("test_edge_list_2.mtx", edge_list_format::MATRIX_MARKET) == true);
+    assert(D.count_edge() == 9);
+    assert(D.reachable(D.label(4), D.label(0)) == true);
+
+    write_file("test_edge_list_3.mtx",
+        "%%MatrixMarket matrix coordinate real general\n"
+        "3 3 3\n"
+        "1 2 0.5\n"
+        "2 3 -1.25e1\n"
+        "1 3 1e2\n");
+    graph<int, true, true, double> W;
+    assert(W.read_edge_list("test_edge_list_3.mtx", edge_list_format::MATRIX_MARKET) == true);
+    std::function<double(double)> get_weight = [](double x)
+    {
+        return x;
+    };
+    auto d = W.single_source_shortest_path_ids(W.label(0), get_weight);
+    std::vector<double> distance(3);
+    for (auto &x : d)
+    {
+        distance[x.node] = x.distance;
+    }
+    assert(distance[1] == 0.5 && distance[2] == -12);
+
+    write_file("test_edge_list_4.mtx", "%%MatrixMarket matrix array real general\n2 2\n1\n2\n3\n4\n");
+    graph<int, true> A;     //dense matrices are not edge lists
+    assert(A.read_edge_list("test_edge_list_4.mtx", edge_list_format::MATRIX_MARKET) == false);
+    assert(A.count_node() == 0);
+    std::remove("test_edge_list_2.mtx");
+    std::remove("test_edge_list_3.mtx");
+    std::remove("test_edge_list_4.mtx");
+}
+
+
+void test_case_3()  //DIMACS arcs with integer weights
+{
+    write_file("test_edge_list_5.gr",
+        "c 9th DIMACS Implementation Challenge\n"
+        "p sp 4 5\n"
+        "c arcs\n"
+        "a 1 2 4\n"
+        "a 1 3 1\n"
+        "a 3 2 2\n"
+        "a 2 4 5\n"
+        "a 3 4 8");    //no newline after the last arc
+    graph<long long, true, true, long long> G;
+    assert(G.read_edge_list("test_edge_list_5.gr", edge_list_format::DIMACS, 8) == true);
+    assert(G.count_node() == 4 && G.count_edge() == 5);
+    std::function<long long(long long)> get_weight = [](long long x)
+    {
+        return x;
+    };
+    auto d = G.single_source_shortest_path_ids(G.label(0), get_weight);
+    std::vector<long long> distance(4);
+    for (auto &x : d)
+    {
+        distance[x.node] = x.distance;
+    }
+    assert(distance == std::vector<long long>({ 0, 3, 1, 8 }));
+
+    write_file("test_edge_list_6.gr", "p sp 2 1\na 1 3 1\n");
+    graph<int, true> R;     //node 3 is outside of the problem line
+    assert(R.read_edge_list("test_edge_list_6.gr", edge_list_format::DIMACS) == false);
+    std::remove("test_edge_list_5.gr");
+    std::remove("test_edge_list_6.gr");
+}
+
+
+void test_case_4()  //files and graphs which must be refused, add_edges on a graph with edges
+{
+    write_file("test_edge_list_7.txt", "1 2\n2 x\n");
+    graph<int, true> B;
+    assert(B.read_edge_list("test_edge_list_7.txt", edge_list_format::SNAP) == false);
+    assert(B.count_node() == 0);
+    graph<int, true> M;
+    assert(M.read_edge_list("no_such_edge_list.txt", edge_list_format::SNAP) == false);
+
+    write_file("test_edge_list_8.txt", "1 2\n2 3\n");
+    graph<int, true> F;
+    int x = 9;
+    F.add_node(x);
+    assert(F.read_edge_list("test_edge_list_8.txt", edge_list_format::SNAP) == false);
+
+    graph<int, false, true, int> G;
+    std::vector<int> v = { 10, 20, 30, 40 };
+    G.add_node(v);
+    G.add_edges({ { 0, 1 }, { 1, 0 }, { 2, 2 }, { 3, 7 }, { 1, 2 } }, { 5, 6, 7, 8, 9 });
+    assert(G.count_edge() == 3);     //{1, 0} repeats {0, 1} and 7 is not a node
+    assert(number_of_components(G.connected_components()) == 2);
+    G.add_edges({ { 2, 3 }, { 1, 2 } });
+    assert(G.count_edge() == 4);
+    assert(number_of_components(G.connected_components()) == 1);
+
+    graph<int, false, true, int> W;     //fewer edges than pairs, refused before anything changes
+    W.add_node(v);
+    W.add_edges({ { 0, 1 }, { 1, 2 }, { 0, 2 } }, { 5 });
+    assert(W.count_edge() == 0);
+    W.add_edges({ { 0, 1 } }, { 5, 6 });
+    assert(W.count_edge() == 0);
+    std::remove("test_edge_list_7.txt");
+    std::remove("test_edge_list_8.txt");
+}
+
+
+void run_test()
+{
+    test_case_1();
+    test_case_2();
+    test_case_3();
+    test_case_4();
+}
+
+int main()
+{
+    run_test();
+
+    return 0;
+}
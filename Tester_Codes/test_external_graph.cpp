@@ -0,0 +1,189 @@
+#include "../source/graph_library.h"
+#include <cassert>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+
+
+std::vector<int> distances(const std::vector<traversal<int, int> > &order, int n)
+{
+    std::vector<int> d(n, -1);
+    for (auto &x : order)
+    {
+        d[x.node] = x.distance;
+    }
+    return d;
+}
+
+
+void test_case_1()  //undirected weighted graph with a tiny budget, so there are many runs and shards
+{
+    const int n = 600;
+    std::mt19937 random_generator(11);
+    external_graph<int> X(".", n, false, 4096);
+    graph<int, false, true, int> G;
+    std::vector<int> v(n);
+    for (int i = 0; i < n; i++)
+    {
+        v[i] = i;
+    }
+    G.add_node(v);
+    std::cout.setstate(std::ios::failbit);  //repeated edges are reported by add_edge
+    for (int k = 0; k < 3 * n; k++)
+    {
+        int a = random_generator() % n, b = random_generator() % (n - 50);   //the last 50 nodes are only reached from a few edges
+        int w = (a * 31 + b * 17) % 100;
+        X.add_edge(a, b, w);
+        G.add_edge(v[a], v[b], w);
+        if (k % 7 == 0)
+        {
+            X.add_edge(b, a, w + 1);    //same edge again, the first weight is kept
+        }
+    }
+    std::cout.clear();
+    assert(X.count_edge() == G.count_edge());
+    assert(X.count_shard() > 1);
+
+    for (int s = 0; s < n; s += 53)
+    {
+        assert(distances(X.bfs_ids(s), n) == distances(G.bfs_ids(v[s]), n));
+    }
+    assert(X.connected_components() == G.connected_components());
+
+    std::function<int(int)> get_weight = [](int x)
+    {
+        return x;
+    };
+    auto a = X.krushkal_minimum_spanning_tree(get_weight);
+    auto b = G.krushkal_minimum_spanning_tree(get_weight);
+    assert(a.first == b.first && a.second.size() == b.second.size());
+
+    int edges = 0;
+    X.for_each_edge([&](int i, int j, const int &w)
+        {
+            edges += (i <= j);
+            assert(G.id(v[i]) == i);
+        });
+    assert(edges == G.count_edge());
+}
+
+
+void test_case_2()  //directed graph, edges added after the first pass are merged with the old shards
+{
+    const int n = 400;
+    std::mt19937 random_generator(12);
+    external_graph<void> X(".", n, true, 2048);
+    graph<int, true, false, void> G;
+    std::vector<int> v(n);
+    for (int i = 0; i < n; i++)
+    {
+        v[i] = i;
+    }
+    G.add_node(v);
+    std::cout.setstate(std::ios::failbit);
+    for (int round = 0; round < 2; round++)
+    {
+        for (int k = 0; k < 2 * n; k++)
+        {
+            int a = random_generator() % n, b = random_generator() % n;
+            X.add_edge(a, b);
+            G.add_edge(v[a], v[b]);
+        }
+        assert(X.count_edge() == G.count_edge());
+        for (int s = 0; s < n; s += 37)
+        {
+            assert(distances(X.bfs_ids(s), n) == distances(G.bfs_ids(v[s]), n));
+        }
+    }
+    X.add_edge(n, 0);       //not a node
+    std::cout.clear();
+    assert(X.connected_components() == G.weakly_connected_components());
+}
+
+
+void test_case_3()  //PageRank against the same iteration in memory
+{
+    const int n = 300;
+    std::mt19937 random_generator(13);
+    external_graph<void> X(".", n, true, 1024);
+    std::vector<std::vector<int> > out(n);
+    for (int k = 0; k < 4 * n; k++)
+    {
+        int a = random_generator() % (n - 20), b = random_generator() % n;     //the last 20 nodes have no outgoing edges
+        if (std::find(out[a].begin(), out[a].end(), b) == out[a].end())
+        {
+            out[a].push_back(b);
+        }
+        X.add_edge(a, b);
+    }
+    std::vector<double> rank(n, 1.0 / n);
+    for (int iteration = 0; iteration < 30; iteration++)
+    {
+        std::vector<double> next(n, 0);
+        double dangling = 0;
+        for (int i = 0; i < n; i++)
+        {
+            if (out[i].empty() == true)
+            {
+                dangling += rank[i];
+            }
+            for (int j : out[i])
+            {
+                next[j] += rank[i] / out[i].size();
+            }
+        }
+        for (int i = 0; i < n; i++)
+        {
+            next[i] = 0.15 / n + 0.85 * (next[i] + dangling / n);
+        }
+        rank = next;
+    }
+    auto x = X.page_rank(30);
+    double sum = 0;
+    for (int i = 0; i < n; i++)
+    {
+        assert(std::abs(x[i] - rank[i]) < 1e-12);
+        sum += x[i];
+    }
+    assert(std::abs(sum - 1) < 1e-9);
+
+    external_graph<void> Y(".", 5, false);  //no edges at all
+    assert(Y.count_edge() == 0 && Y.count_shard() == 0);
+    assert(Y.bfs_ids(2).size() == 1);
+    assert(Y.connected_components() == std::vector<int>({ 0, 1, 2, 3, 4 }));
+
+    external_graph<void> A(".", 100, true, 256), B(".", 100, true, 256);   //same directory, files of their own
+    for (int k = 0; k < 500; k++)
+    {
+        A.add_edge(k % 100, (k * 7 + 1) % 100);
+        B.add_edge(k % 50, k % 50);
+    }
+    int in_a = 0, in_b = 0;
+    A.for_each_edge([&](int from, int to, const no_edge&)
+        {
+            assert(to == (from * 7 + 1) % 100);
+            in_a++;
+        });
+    B.for_each_edge([&](int from, int to, const no_edge&)
+        {
+            assert(from == to && from < 50);
+            in_b++;
+        });
+    assert(in_a == 100 && in_b == 50);
+}
+
+
+void run_test()
+{
+    test_case_1();
+    test_case_2();
+    test_case_3();
+}
+
+int main()
+{
+    run_test();
+
+    return 0;
+}
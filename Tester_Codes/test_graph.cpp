@@ -2,6 +2,10 @@
 #include <iostream>
 #include <cassert>
 #include <vector>
+#include <random>
+#include <functional>
+#include <cstdint>
+#include <thread>
 
 void test_case_1()
 {
@@ -55,10 +59,193 @@ void test_case_1()
     
 }
 
+template<typename S>
+void compare_with_default(int seed)     //every algorithm must give the same answer whatever the width of the ids
+{
+    const int n = 120;
+    std::mt19937 random_generator(seed);
+    graph<int, true, false, int> A;
+    graph<int, true, false, int, S> B;
+    graph<int, false, true, int> C;
+    graph<int, false, true, int, S> D;
+    std::vector<int> v(n);
+    for (int i = 0; i < n; i++)
+    {
+        v[i] = i;
+    }
+    A.add_node(v);
+    B.add_node(v);
+    C.add_node(v);
+    D.add_node(v);
+
+    for (int k = 0; k < 3 * n; k++)
+    {
+        int a = random_generator() % n, b = random_generator() % n, w = 1 + random_generator() % 50;
+        A.add_edge(v[a], v[b]);
+        B.add_edge(v[a], v[b]);
+        if (a != b)
+        {
+            C.add_edge(v[a], v[b], w);
+            D.add_edge(v[a], v[b], w);
+        }
+    }
+
+    auto scc_a = A.scc_ids();
+    auto scc_b = B.scc_ids();
+    assert(scc_a.size() == scc_b.size());
+    for (size_t c = 0; c < scc_a.size(); c++)
+    {
+        assert(scc_a[c].size() == scc_b[c].size());
+        for (size_t k = 0; k < scc_a[c].size(); k++)
+        {
+            assert(size_t(scc_a[c][k]) == size_t(scc_b[c][k]));
+        }
+    }
+    assert(A.condensation().dag.count_edge() == B.condensation().dag.count_edge());
+
+    for (int i = 0; i < n; i += 7)
+    {
+        auto bfs_a = A.bfs_ids(v[i]);
+        auto bfs_b = B.bfs_ids(v[i]);
+        assert(bfs_a.size() == bfs_b.size());
+        for (size_t k = 0; k < bfs_a.size(); k++)
+        {
+            assert(size_t(bfs_a[k].node) == size_t(bfs_b[k].node) && size_t(bfs_a[k].distance) == size_t(bfs_b[k].distance));
+        }
+        auto dfs_a = A.dfs(v[i], 3);     //limited depth goes through the same checks as the unlimited one
+        auto dfs_b = B.dfs(v[i], 3);
+        assert(dfs_a.size() == dfs_b.size());
+        size_t count = 0;
+        for (auto &t : B.dfs_range(v[i]))
+        {
+            count += (t.node == t.parent);
+        }
+        assert(count == 1);     //only the source is its own parent
+        for (int j = 0; j < n; j += 11)
+        {
+            assert(A.reachable(v[i], v[j]) == B.reachable(v[i], v[j]));
+        }
+    }
+
+    std::function<int(int)> get_weight = [](int x)
+    {
+        return x;
+    };
+    assert(C.krushkal_minimum_spanning_tree(get_weight).first == D.krushkal_minimum_spanning_tree(get_weight).first);
+    assert(C.boruvka_minimum_spanning_tree(get_weight, 2).first == D.krushkal_minimum_spanning_tree(get_weight).first);
+    assert(C.prims_minimum_spanning_tree(get_weight).first == D.prims_minimum_spanning_tree(get_weight).first);
+    incremental_minimum_spanning_forest<int, int, int, S> F(D, get_weight);
+    assert(F.total_weight() == C.krushkal_minimum_spanning_tree(get_weight).first);
+
+    auto sssp_c = C.single_source_shortest_path(v[0], get_weight);
+    auto sssp_d = D.single_source_shortest_path(v[0], get_weight);
+    assert(sssp_c.size() == sssp_d.size());
+    for (size_t k = 0; k < sssp_c.size(); k++)
+    {
+        assert(sssp_c[k].node == sssp_d[k].node && sssp_c[k].distance == sssp_d[k].distance);
+    }
+
+    auto component_c = C.connected_components(components_algorithm::AFFOREST, 2);
+    auto component_d = D.connected_components(components_algorithm::AFFOREST, 2);
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j += 13)
+        {
+            assert((component_c[i] == component_c[j]) == (component_d[i] == component_d[j]));
+        }
+    }
+}
+
+
+void test_case_2()
+{
+    compare_with_default<vector_storage<uint32_t, uint64_t> >(3);
+    compare_with_default<vector_storage<int64_t, int64_t> >(5);
+    compare_with_default<pooled_storage<3, uint64_t, uint64_t> >(7);
+}
+
+
+void test_case_3()  //many threads query one const graph, frozen or not, and get what one thread gets
+{
+    const int n = 800;
+    std::mt19937 random_generator(14);
+    graph<int, true, true, int> G;
+    std::vector<int> v(n);
+    for (int i = 0; i < n; i++)
+    {
+        v[i] = i * 2;
+    }
+    G.add_node(v);
+    for (int k = 0; k < 4 * n; k++)
+    {
+        int a = random_generator() % n, b = random_generator() % n;
+        G.add_edge(v[a], v[b], 1 + (a * b) % 20);
+    }
+    std::function<int(int)> get_weight = [](int x)
+    {
+        return x;
+    };
+
+    for (int round = 0; round < 2; round++)
+    {
+        const auto &C = G;
+        std::vector<std::vector<traversal<int, int64_t> > > distances(n);
+        std::vector<std::vector<traversal<int, int> > > orders(n);
+        for (int s = 0; s < n; s += 7)
+        {
+            distances[s] = C.single_source_shortest_path_ids(v[s], get_weight);
+            orders[s] = C.bfs_ids(v[s]);
+        }
+        auto components = C.scc_ids();
+
+        std::vector<std::thread> threads;
+        std::vector<int> is_same(8, true);
+        for (int t = 0; t < 8; t++)
+        {
+            threads.emplace_back([&, t]()
+                {
+                    for (int s = t; s < n; s += 7 * 8)
+                    {
+                        if (s % 7 != 0)
+                        {
+                            continue;
+                        }
+                        auto d = C.single_source_shortest_path_ids(v[s], get_weight);
+                        auto o = C.bfs_ids(C.label(C.id(v[s])));
+                        for (size_t k = 0; k < d.size(); k++)
+                        {
+                            is_same[t] &= (d[k].node == distances[s][k].node && d[k].distance == distances[s][k].distance);
+                        }
+                        for (size_t k = 0; k < o.size(); k++)
+                        {
+                            is_same[t] &= (o[k].node == orders[s][k].node);
+                        }
+                    }
+                    is_same[t] &= (C.scc_ids() == components);
+                    int missing = -1;
+                    is_same[t] &= (C.bfs(missing).empty() == true && C.id(missing) == -1);  //a lookup never inserts
+                });
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+        for (int t = 0; t < 8; t++)
+        {
+            assert(is_same[t] == true);
+        }
+        G.freeze();     //the second round reads the compressed rows
+        assert(C.frozen() == true);
+    }
+    assert(G.frozen() == true);
+}
+
 
 void run_test()
 {
     test_case_1();
+    test_case_2();
+    test_case_3();
 }
 
 int main()
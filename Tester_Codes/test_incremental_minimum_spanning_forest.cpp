@@ -0,0 +1,123 @@
+#include "../source/graph_library.h"
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include <random>
+
+#define EPS 1e-7 //the tolerance value in comparison of floating point values
+
+
+void test_case_1()  //Example from Introduction to Algorithms by Cormen, edges added one at a time
+{
+	graph<char, false, true, int> G;
+	std::vector<char> v(9);
+
+	for (int i = 0; i < 9; i++)
+	{
+		v[i] = char(i + 'a');
+	}
+	G.add_node(v);
+
+	G.add_edge(v[0], v[1], 4);	//edges present before the forest is created are picked up too
+	G.add_edge(v[0], v[7], 8);
+
+	std::function<int(int)> get_weight = [](int x)
+	{
+		return x;
+	};
+
+	incremental_minimum_spanning_forest<char, int, int> F(G, get_weight);
+
+	assert(F.total_weight() == 12);
+	assert(F.count_edge() == 2);
+
+	F.add_edge(v[1], v[7], 11);	//closes a cycle and is the heaviest, so it is left out
+	assert(F.total_weight() == 12);
+	assert(F.count_edge() == 2);
+
+	F.add_edge(v[1], v[2], 8);
+	F.add_edge(v[2], v[3], 7);
+	F.add_edge(v[2], v[5], 4);
+	F.add_edge(v[2], v[8], 2);
+	F.add_edge(v[3], v[4], 9);
+	F.add_edge(v[3], v[5], 14);
+	F.add_edge(v[4], v[5], 10);
+	F.add_edge(v[5], v[6], 2);
+	F.add_edge(v[6], v[7], 1);	//replaces a heavier edge on the cycle
+	F.add_edge(v[6], v[8], 6);
+	F.add_edge(v[7], v[8], 7);
+
+	assert(G.count_edge() == 14);
+	assert(F.total_weight() == 37);
+	assert(F.count_edge() == 8);
+
+	int total = 0;
+	for (auto &x : F.edges())
+	{
+		total += x.edge;
+	}
+	assert(total == 37);
+
+	F.add_edge(v[7], v[8], 0);	//already present, the graph refuses it and so does the forest
+	assert(F.total_weight() == 37);
+}
+
+
+void test_case_2()  //random insertions compared with Krushkal after every batch
+{
+	const int n = 150;
+	std::mt19937 random_generator(5);
+	graph<int, false, true, double> G;
+	std::vector<int> v(n);
+
+	for (int i = 0; i < n; i++)
+	{
+		v[i] = i;
+	}
+	G.add_node(v);
+
+	std::function<double(double)> get_weight = [](double x)
+	{
+		return x;
+	};
+
+	incremental_minimum_spanning_forest<int, double, double> F(G, get_weight);
+
+	for (int batch = 0; batch < 20; batch++)
+	{
+		for (int k = 0; k < 60; k++)
+		{
+			int a = random_generator() % n, b = random_generator() % n;
+			if (a != b)
+			{
+				F.add_edge(v[a], v[b], (random_generator() % 10000) / 100.0);
+			}
+		}
+		auto mst = G.krushkal_minimum_spanning_tree(get_weight);
+		assert(fabsl(mst.first - F.total_weight()) < EPS);
+		assert(mst.second.size() == F.count_edge());
+	}
+
+	std::vector<int> more(2);	//nodes added to the graph later are picked up by the forest
+	more[0] = n;
+	more[1] = n + 1;
+	G.add_node(more);
+	F.add_edge(more[0], more[1], 1.5);
+	F.add_edge(more[1], v[0], 2.5);
+	auto mst = G.krushkal_minimum_spanning_tree(get_weight);
+	assert(fabsl(mst.first - F.total_weight()) < EPS);
+}
+
+
+void run_test()
+{
+	test_case_1();
+	test_case_2();
+}
+
+int main()
+{
+	run_test();
+
+	return 0;
+}
@@ -0,0 +1,256 @@
+#include "../source/graph_library.h"
+#include <cassert>
+#include <vector>
+#include <random>
+#include <atomic>
+#include <thread>
+#include <chrono>
+
+
+template<typename T>
+std::vector<T> distances(const std::vector<traversal<int, T> > &order, int n, typename std::common_type<T>::type unreachable)   //T only from the results
+{
+    std::vector<T> d(n, unreachable);
+    for (auto &x : order)
+    {
+        d[x.node] = x.distance;
+    }
+    return d;
+}
+
+
+template<typename G, typename = void>
+struct takes_temporary : std::false_type {};
+
+template<typename G>
+struct takes_temporary<G, std::void_t<decltype(std::declval<G&>().bfs(0))> > : std::true_type {};    //would silently miss
+
+
+void test_case_1()  //unweighted directed graph, queries from many client threads against the graph itself
+{
+    const int n = 1500;
+    std::mt19937 random_generator(41);
+    graph<int, true> G;
+    std::vector<int> v(n);
+    for (int i = 0; i < n; i++)
+    {
+        v[i] = i * 3;
+    }
+    G.add_node(v);
+    std::vector<std::pair<int, int> > pairs;
+    for (int k = 0; k < 4 * n; k++)
+    {
+        pairs.push_back({ int(random_generator() % n), int(random_generator() % n) });
+    }
+    G.add_edges(pairs);
+
+    query_engine<int, true> Q(G, nullptr, execution_policy(3), 64, 4);
+    std::vector<std::thread> clients;
+    for (int c = 0; c < 4; c++)
+    {
+        clients.emplace_back([&, c]()
+            {
+                for (int s = c; s < n; s += 97)
+                {
+                    auto a = Q.bfs(v[s], 3);
+                    auto b = Q.single_source_shortest_path(v[s]);
+                    int target = (s * 7 + 11) % n;
+                    auto p = Q.shortest_path(v[s], v[target]);
+                    assert(distances(a.get(), n, -1) == distances(G.bfs_ids(v[s], 3), n, -1));
+                    auto d = distances(b.get(), n, -1);
+                    assert(d == distances(G.single_source_shortest_path_ids(v[s]), n, -1));
+                    auto path = p.get();
+                    if (d[target] == std::numeric_limits<int>::max())
+                    {
+                        assert(path.empty() == true);
+                        continue;
+                    }
+                    assert(int(path.size()) == d[target] + 1 && path.front().node == s && path.back().node == target);
+                    for (size_t k = 1; k < path.size(); k++)
+                    {
+                        auto next = G.bfs_ids(v[path[k - 1].node], 2);
+                        assert(path[k].parent == path[k - 1].node && path[k].distance == int(k));
+                        assert(std::find_if(next.begin(), next.end(), [&](auto &x) { return x.node == path[k].node; }) != next.end());
+                    }
+                }
+            });
+    }
+    for (auto &x : clients)
+    {
+        x.join();
+    }
+    int missing = 1;
+    assert(Q.bfs(missing).get().empty() == true);    //not a node, equal to a label is not enough
+    assert(Q.shortest_path(v[0], missing).get().empty() == true);
+    static_assert(takes_temporary<graph<int, true> >::value == false && takes_temporary<query_engine<int, true> >::value == false);
+}
+
+
+void test_case_2()  //weighted graphs, frozen and with negative weights
+{
+    const int n = 800;
+    std::mt19937 random_generator(42);
+    graph<int, false, true, int> G;
+    std::vector<int> v(n);
+    for (int i = 0; i < n; i++)
+    {
+        v[i] = i;
+    }
+    G.add_node(v);
+    std::vector<std::pair<int, int> > pairs;
+    std::vector<int> w;
+    for (int k = 0; k < 3 * n; k++)
+    {
+        pairs.push_back({ int(random_generator() % n), int(random_generator() % (n - 30)) });
+        w.push_back(1 + random_generator() % 40);
+    }
+    G.add_edges(pairs, w);
+    G.freeze();
+    std::function<int(int)> get_weight = [](int x)
+    {
+        return x;
+    };
+    query_engine<int, false, true, int> Q(G, get_weight);
+    for (int s = 0; s < n; s += 53)
+    {
+        auto expected = distances(G.single_source_shortest_path_ids(v[s], get_weight), n, -1);
+        assert(distances(Q.single_source_shortest_path(v[s]).get(), n, -1) == expected);
+        std::vector<query_future<query_engine<int, false, true, int>::path_result> > paths;
+        for (int t = 0; t < n; t += 61)
+        {
+            paths.push_back(Q.shortest_path(v[s], v[t]));     //all of them share one search
+        }
+        for (int t = 0, k = 0; t < n; t += 61, k++)
+        {
+            auto path = paths[k].get();
+            if (expected[t] == (int64_t)INF)
+            {
+                assert(path.empty() == true);
+            }
+            else
+            {
+                assert(path.front().node == s && path.back().node == t && path.back().distance == expected[t]);
+            }
+        }
+    }
+
+    graph<int, true, true, int> D;      //a negative edge, the engine leaves the algorithm to the graph
+    std::vector<int> u = { 0, 1, 2, 3 };
+    D.add_node(u);
+    D.add_edge(u[0], u[1], 4);
+    D.add_edge(u[0], u[2], 1);
+    D.add_edge(u[1], u[3], -3);
+    D.add_edge(u[2], u[3], 2);
+    query_engine<int, true, true, int> R(D, get_weight, 2);
+    auto path = R.shortest_path(u[0], u[3]).get();
+    assert(path.size() == 3 && path[1].node == 1 && path[2].distance == 1);
+    assert(distances(R.single_source_shortest_path(u[0]).get(), 4, -1) == std::vector<int64_t>({ 0, 4, 1, 1 }));
+}
+
+
+void test_case_3()  //identical queries run once, a full engine holds the caller back, cancelled queries end empty
+{
+    graph<int, false> G;
+    std::vector<int> v = { 0, 1, 2, 3, 4 };
+    G.add_node(v);
+    for (int i = 0; i + 1 < 5; i++)
+    {
+        G.add_edge(v[i], v[i + 1]);
+    }
+    thread_pool pool(1);
+    std::atomic<bool> is_released{ false };
+    pool.submit([&]()   //keeps the only worker busy, so nothing queued can start
+        {
+            while (is_released.load() == false)
+            {
+                std::this_thread::yield();
+            }
+        });
+    query_engine<int, false> Q(G, nullptr, execution_policy(1, &pool), 4);
+    auto a = Q.single_source_shortest_path(v[0]);
+    auto b = Q.single_source_shortest_path(v[0]);
+    auto c = Q.shortest_path(v[0], v[4]);
+    auto d = Q.shortest_path(v[0], v[2]);
+    assert(Q.pending() == 4);
+    b.cancel();
+    c.cancel();
+
+    std::atomic<bool> is_accepted{ false };
+    std::thread client([&]()
+        {
+            auto e = Q.bfs(v[4]);
+            is_accepted.store(true);
+            assert(e.get().size() == 5);
+        });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    assert(is_accepted.load() == false);    //the engine is full
+    assert(a.is_ready() == false);
+    is_released.store(true);
+    client.join();
+
+    assert(a.get().size() == 5 && b.get().empty() == true);
+    assert(c.get().empty() == true && d.get().size() == 3);
+    while (Q.pending() > 0)     //the count goes down right after the results are given
+    {
+        std::this_thread::yield();
+    }
+}
+
+
+void test_case_4()  //tasks on the engine's own pool submit past capacity, they must answer batches instead of waiting
+{
+    const int n = 200;
+    graph<int, true> G;
+    std::vector<int> v(n);
+    for (int i = 0; i < n; i++)
+    {
+        v[i] = i;
+    }
+    G.add_node(v);
+    for (int i = 0; i + 1 < n; i++)
+    {
+        G.add_edge(v[i], v[i + 1]);
+    }
+    thread_pool pool(2);
+    query_engine<int, true> Q(G, nullptr, execution_policy(2, &pool), 4, 2);
+    std::vector<std::vector<query_future<query_engine<int, true>::bfs_result> > > results(8);
+    std::atomic<int> finished{ 0 };
+    for (int k = 0; k < 8; k++)
+    {
+        pool.submit([&, k]()
+            {
+                for (int s = k; s < n; s += 8)
+                {
+                    results[k].push_back(Q.bfs(v[s]));
+                }
+                finished.fetch_add(1);
+            });
+    }
+    while (finished.load() < 8)
+    {
+        std::this_thread::yield();
+    }
+    for (int k = 0; k < 8; k++)
+    {
+        for (int s = k, t = 0; s < n; s += 8, t++)
+        {
+            assert(int(results[k][t].get().size()) == n - s);
+        }
+    }
+}
+
+
+void run_test()
+{
+    test_case_1();
+    test_case_2();
+    test_case_3();
+    test_case_4();
+}
+
+int main()
+{
+    run_test();
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include "../source/graph_library.h"
+#include <cassert>
+#include <vector>
+#include <random>
+
+void test_case_1()  //graph from Gabow's Paper
+{
+    graph<int, true> G;
+    std::vector<int> v(6);
+
+    for (int i = 0; i < 6; i++)
+    {
+        v[i] = i + 1;
+    }
+
+    G.add_node(v);
+
+    G.add_edge(v[0], v[1]);
+    G.add_edge(v[0], v[2]);
+    G.add_edge(v[1], v[2]);
+    G.add_edge(v[1], v[3]);
+    G.add_edge(v[3], v[2]);
+    G.add_edge(v[3], v[4]);
+    G.add_edge(v[4], v[1]);
+    G.add_edge(v[4], v[5]);
+    G.add_edge(v[5], v[3]);
+    G.add_edge(v[5], v[2]);
+
+    assert(G.reachable(v[0], v[5]) == true);
+    assert(G.reachable(v[5], v[1]) == true);   //same component
+    assert(G.reachable(v[5], v[0]) == false);
+    assert(G.reachable(v[2], v[0]) == false);
+    assert(G.reachable(v[2], v[2]) == true);
+
+    int extra = 7;
+    G.add_node(extra);
+    assert(G.reachable(v[2], extra) == false);
+    G.add_edge(v[2], extra);                    //index must be rebuilt after the graph changes
+    assert(G.reachable(v[0], extra) == true);
+    assert(G.reachable(extra, v[2]) == false);
+
+    G.remove_edge(v[2], extra);                 //same number of nodes and edges, still a different graph
+    G.add_edge(extra, v[0]);
+    assert(G.reachable(v[0], extra) == false);
+    assert(G.reachable(extra, v[5]) == true);
+}
+
+
+void test_case_2()  //compare with bfs on a random graph, for both the bitset closure and the interval labels
+{
+    const int n = 300;
+    std::mt19937 random_generator(42);
+    graph<int, true> G;
+    std::vector<int> v(n);
+
+    for (int i = 0; i < n; i++)
+    {
+        v[i] = i;
+    }
+    G.add_node(v);
+
+    for (int k = 0; k < 2 * n; k++)
+    {
+        int a = random_generator() % n, b = random_generator() % n;
+        if (k % 5 != 0 && a < b)    //mostly forward edges so the condensation has many components
+        {
+            std::swap(a, b);
+        }
+        G.add_edge(v[a], v[b]);
+    }
+
+    std::vector<std::vector<bool> > expected(n, std::vector<bool>(n, false));
+    for (int i = 0; i < n; i++)
+    {
+        for (auto &x : G.bfs(v[i]))
+        {
+            expected[i][x.node] = true;
+        }
+    }
+
+    for (size_t budget : { size_t(REACHABILITY_MEMORY_BUDGET), size_t(4096), size_t(0) })
+    {
+        G.build_reachability_index(budget);
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                assert(G.reachable(v[i], v[j]) == expected[i][j]);
+            }
+        }
+    }
+}
+
+
+void run_test()
+{
+    test_case_1();
+    test_case_2();
+}
+
+int main()
+{
+    run_test();
+
+    return 0;
+}
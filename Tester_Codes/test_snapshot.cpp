@@ -0,0 +1,204 @@
+#include "../source/graph_library.h"
+#include <cassert>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <cstring>
+
+
+std::vector<std::vector<int> > canonical(std::vector<std::vector<int> > groups)
+{
+    for (auto &g : groups)
+    {
+        std::sort(g.begin(), g.end());
+    }
+    std::sort(groups.begin(), groups.end());
+    return groups;
+}
+
+
+void test_case_1()  //directed graph with string labels, the loaded graph answers from the mapped rows
+{
+    const int n = 500;
+    std::mt19937 random_generator(8);
+    graph<std::string, true, false, void> G;
+    std::vector<std::string> v(n);
+    for (int i = 0; i < n; i++)
+    {
+        v[i] = "node_" + std::to_string(i * 37 % 1000);
+    }
+    G.add_node(v);
+    for (int k = 0; k < 4 * n; k++)
+    {
+        int a = random_generator() % n, b = random_generator() % n;
+        if ((a + b) % 13 != 0)
+        {
+            G.add_edge(v[a], v[b]);
+        }
+    }
+    G.remove_node(v[3]);    //save compacts it away
+
+    assert(G.save("test_snapshot_1.bin") == true);
+    graph<std::string, true, false, void> H;
+    assert(H.load("test_snapshot_1.bin") == true);
+    assert(H.frozen() == true);
+    assert(H.count_node() == G.count_node() && H.count_edge() == G.count_edge());
+
+    for (int s = 0; s < n; s += 41)
+    {
+        if (s == 3)
+        {
+            continue;
+        }
+        int i = G.id(v[s]), j = G.id(v[(s * 5) % n]);    //the labels of H are its own copies, with the same ids
+        assert(H.label(i) == v[s]);
+        auto a = G.bfs_ids(v[s]), b = H.bfs_ids(H.label(i));
+        assert(a.size() == b.size());
+        for (size_t k = 0; k < a.size(); k++)
+        {
+            assert(a[k].node == b[k].node && a[k].distance == b[k].distance);
+        }
+        if (j != -1)
+        {
+            assert(G.reachable(v[s], v[(s * 5) % n]) == H.reachable(H.label(i), H.label(j)));
+        }
+    }
+    assert(canonical(G.scc_ids()) == canonical(H.scc_ids()));
+    assert(G.weakly_connected_components() == H.weakly_connected_components());
+    assert(H.frozen() == true);
+
+    auto L = std::make_unique<graph<std::string, true, false, void> >();
+    assert(L->load("test_snapshot_1.bin") == true);
+    graph<std::string, true, false, void> K(*L);    //a copy still reads the mapping after the original is gone
+    L.reset();
+    assert(canonical(K.scc_ids()) == canonical(G.scc_ids()));
+
+    assert(H.save("test_snapshot_1.bin") == true);  //H still maps the file it replaces
+    assert(canonical(H.scc_ids()) == canonical(G.scc_ids()));
+
+    std::string extra = "extra";
+    H.add_node(extra);          //thaws the mapped rows into plain ones
+    H.add_edge(H.label(G.id(v[0])), extra);
+    assert(H.frozen() == false);
+    assert(H.count_edge() == G.count_edge() + 1);
+    std::remove("test_snapshot_1.bin");
+}
+
+
+void test_case_2()  //weighted undirected graph, the edges must come back with their targets
+{
+    const int n = 300;
+    std::mt19937 random_generator(9);
+    graph<int, false, true, double> G;
+    std::vector<int> v(n);
+    for (int i = 0; i < n; i++)
+    {
+        v[i] = i * 3;
+    }
+    G.add_node(v);
+    for (int k = 0; k < 3 * n; k++)
+    {
+        int a = random_generator() % n, b = random_generator() % n;
+        if (a != b)
+        {
+            G.add_edge(v[a], v[b], (a * b % 97) / 4.0);
+        }
+    }
+    assert(G.save("test_snapshot_2.bin") == true);
+    graph<int, false, true, double> H;
+    assert(H.load("test_snapshot_2.bin") == true);
+    assert(G.connected_components() == H.connected_components());
+
+    std::function<double(double)> get_weight = [](double x)
+    {
+        return x;
+    };
+    auto a = G.single_source_shortest_path_ids(v[0], get_weight), b = H.single_source_shortest_path_ids(H.label(G.id(v[0])), get_weight);
+    std::vector<double> da(n), db(n);
+    for (size_t k = 0; k < a.size(); k++)
+    {
+        da[a[k].node] = a[k].distance;
+        db[b[k].node] = b[k].distance;
+    }
+    assert(da == db);
+    assert(H.frozen() == true && H.all_pair_shortest_path_ids(get_weight).size() == size_t(n) * n);    //the edges read from the file
+    H.dfs(H.label(G.id(v[0])), [](int&, int&, int)
+        {
+            return traversal_action::CONTINUE;
+        },
+        [&](int &x, int &y, const double &w)    //read in place from the mapped edges
+        {
+            assert(w == ((x / 3) * (y / 3) % 97) / 4.0);
+            return traversal_action::CONTINUE;
+        });
+    assert(H.frozen() == true);
+    assert(G.krushkal_minimum_spanning_tree(get_weight).first == H.krushkal_minimum_spanning_tree(get_weight).first);
+    assert(H.frozen() == false);    //thawed, the edges were copied out before the file was let go
+    H.freeze();
+    assert(H.single_source_shortest_path_ids(H.label(G.id(v[0])), get_weight).size() == b.size());
+    std::remove("test_snapshot_2.bin");
+}
+
+
+void test_case_3()  //files which must be refused
+{
+    graph<int, true> G;
+    std::vector<int> v = { 1, 2, 3 };
+    G.add_node(v);
+    G.add_edge(v[0], v[1]);
+    assert(G.save("test_snapshot_3.bin") == true);
+
+    graph<int, false> U;        //other direction
+    assert(U.load("test_snapshot_3.bin") == false);
+    graph<int, true, false, int, vector_storage<int64_t> > W;    //other index width
+    assert(W.load("test_snapshot_3.bin") == false);
+    graph<int, true> F;         //not empty
+    F.add_node(v[0]);
+    assert(F.load("test_snapshot_3.bin") == false);
+    graph<int, true> M;
+    assert(M.load("no_such_snapshot.bin") == false);
+
+    std::ifstream in("test_snapshot_3.bin", std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    std::ofstream("test_snapshot_3.bin", std::ios::binary).write(bytes.data(), bytes.size() - 8);
+    graph<int, true> T;         //truncated
+    assert(T.load("test_snapshot_3.bin") == false);
+    assert(T.count_node() == 0);
+
+    size_t offsets_at = (sizeof(snapshot_header) + 7) / 8 * 8, rows_at = offsets_at + 4 * sizeof(int64_t);
+    std::string damaged = bytes;
+    int64_t offset = 5;
+    std::memcpy(&damaged[offsets_at + sizeof(int64_t)], &offset, sizeof(offset));   //row 0 would end after row 1 starts
+    std::ofstream("test_snapshot_3.bin", std::ios::binary).write(damaged.data(), damaged.size());
+    graph<int, true> O;
+    assert(O.load("test_snapshot_3.bin") == false);
+    damaged = bytes;
+    assert(damaged[rows_at] == 1 && damaged[rows_at + 1] == 2);     //row 0 is one edge, to the node after it
+    damaged[rows_at + 1] = 20;      //to node 10 of 3
+    std::ofstream("test_snapshot_3.bin", std::ios::binary).write(damaged.data(), damaged.size());
+    graph<int, true> R;
+    assert(R.load("test_snapshot_3.bin") == false);
+    std::ofstream("test_snapshot_3.bin", std::ios::binary).write(bytes.data(), bytes.size());
+    graph<int, true> L;         //the file itself was fine
+    assert(L.load("test_snapshot_3.bin") == true && L.reachable(L.label(0), L.label(1)) == true);
+    std::remove("test_snapshot_3.bin");
+}
+
+
+void run_test()
+{
+    test_case_1();
+    test_case_2();
+    test_case_3();
+}
+
+int main()
+{
+    run_test();
+
+    return 0;
+}
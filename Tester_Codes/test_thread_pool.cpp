@@ -0,0 +1,172 @@
+#include "../source/graph_library.h"
+#include <cassert>
+#include <vector>
+#include <random>
+#include <atomic>
+#include <thread>
+
+
+void test_case_1()  //one owner pushing and popping while thieves steal, every task is taken exactly once
+{
+    const int total = 200000;
+    std::vector<int> items(total);
+    std::vector<std::atomic<int> > taken(total);
+    work_stealing_deque<int> deque;
+    std::atomic<bool> is_done{ false };
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; t++)
+    {
+        thieves.emplace_back([&]()
+            {
+                while (is_done.load() == false || deque.empty() == false)
+                {
+                    if (int *x = deque.steal(); x != nullptr)
+                    {
+                        taken[*x].fetch_add(1);
+                    }
+                }
+            });
+    }
+    for (int i = 0; i < total; i++)
+    {
+        items[i] = i;
+        deque.push(&items[i]);     //the ring grows past its first size while thieves read it
+        if (i % 3 == 0)
+        {
+            if (int *x = deque.pop(); x != nullptr)
+            {
+                taken[*x].fetch_add(1);
+            }
+        }
+    }
+    while (int *x = deque.pop())
+    {
+        taken[*x].fetch_add(1);
+    }
+    is_done.store(true);
+    for (auto &x : thieves)
+    {
+        x.join();
+    }
+    for (int i = 0; i < total; i++)
+    {
+        assert(taken[i].load() == 1);
+    }
+}
+
+
+void test_case_2()  //parallel_for covers the range once and never runs two pieces with the same thread number
+{
+    thread_pool pool(3);
+    for (int number_of_threads : { 2, 4, 7 })
+    {
+        const size_t size = 100003;
+        std::vector<std::atomic<int> > seen(size);
+        std::vector<std::atomic<int> > in_use(number_of_threads);
+        std::vector<long long> sum(number_of_threads, 0);
+        parallel_for(size, execution_policy(number_of_threads, &pool), [&](int t, size_t begin, size_t end)
+            {
+                assert(t >= 0 && t < number_of_threads);
+                assert(in_use[t].exchange(1) == 0);
+                for (size_t i = begin; i < end; i++)
+                {
+                    seen[i].fetch_add(1);
+                    sum[t] += i;
+                }
+                in_use[t].store(0);
+            });
+        long long total = 0;
+        for (int t = 0; t < number_of_threads; t++)
+        {
+            total += sum[t];
+        }
+        assert(total == (long long)size * (size - 1) / 2);
+        for (size_t i = 0; i < size; i++)
+        {
+            assert(seen[i].load() == 1);
+        }
+    }
+
+    int calls = 0;
+    parallel_for(10, 1, [&](int t, size_t begin, size_t end)    //one thread is a plain call
+        {
+            assert(t == 0 && begin == 0 && end == 10);
+            calls++;
+        });
+    parallel_for(0, 4, [&](int, size_t, size_t)
+        {
+            calls++;
+        });
+    assert(calls == 1);
+}
+
+
+void test_case_3()  //nested parallel_for inside submitted tasks, and a pool passed to the graph algorithms
+{
+    thread_pool pool(2);
+    std::atomic<long long> total{ 0 };
+    std::atomic<int> finished{ 0 };
+    for (int k = 0; k < 8; k++)
+    {
+        pool.submit([&]()
+            {
+                parallel_for(1000, execution_policy(4, &pool), [&](int, size_t begin, size_t end)
+                    {
+                        for (size_t i = begin; i < end; i++)
+                        {
+                            total.fetch_add(i);
+                        }
+                    });
+                finished.fetch_add(1);
+            });
+    }
+    while (finished.load() < 8)
+    {
+        std::this_thread::yield();
+    }
+    assert(total.load() == 8LL * 999 * 1000 / 2);
+
+    const int n = 3000;
+    std::mt19937 random_generator(31);
+    graph<int, false, true, int> G;
+    std::vector<int> v(n);
+    for (int i = 0; i < n; i++)
+    {
+        v[i] = i;
+    }
+    G.add_node(v);
+    std::vector<std::pair<int, int> > pairs;
+    std::vector<int> w;
+    for (int k = 0; k < 2 * n; k++)
+    {
+        pairs.push_back({ int(random_generator() % n), int(random_generator() % n) });
+        w.push_back(random_generator() % 100);
+    }
+    G.add_edges(pairs, w, execution_policy(3, &pool));
+    std::function<int(int)> get_weight = [](int x)
+    {
+        return x;
+    };
+    auto a = G.connected_components(components_algorithm::UNION_FIND);
+    auto b = G.connected_components(components_algorithm::AFFOREST, execution_policy(5, &pool, 16));
+    auto c = G.connected_components(components_algorithm::AFFOREST, 3);    //a bare thread count uses the shared pool
+    assert(a == b && a == c);
+    auto x = G.krushkal_minimum_spanning_tree(get_weight);
+    auto y = G.boruvka_minimum_spanning_tree(get_weight, execution_policy(4, &pool));
+    assert(x.first == y.first && x.second.size() == y.second.size());
+}
+
+
+void run_test()
+{
+    test_case_1();
+    test_case_2();
+    test_case_3();
+}
+
+int main()
+{
+    run_test();
+
+    return 0;
+}
@@ -0,0 +1,185 @@
+#include "../source/graph_library.h"
+#include <cassert>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+
+
+template<typename T>
+std::vector<T> distances(const std::vector<traversal<int, T> > &order, int n)
+{
+    std::vector<T> d(n, -1);
+    for (auto &x : order)
+    {
+        d[x.node] = x.distance;
+    }
+    return d;
+}
+
+
+void test_case_1()  //an old snapshot does not see later writes, a new one does
+{
+    versioned_graph<int, true> V(0);     //no background compaction
+    int a = V.add_node(10), b = V.add_node(20), c = V.add_node(30);
+    assert(V.add_edge(a, b) == true);
+    auto before = V.read();
+    assert(V.add_edge(b, c) == true);
+    int d = V.add_node(40);
+    assert(V.add_edge(c, d) == true);
+    auto after = V.read();
+
+    assert(before.count_node() == 3 && before.count_edge() == 1);
+    assert(before.has_edge(a, b) == true && before.has_edge(b, c) == false);
+    assert(before.bfs_ids(a).size() == 2);
+    assert(before.neighbours(d).empty() == true);       //not a node of that version
+    assert(after.count_node() == 4 && after.count_edge() == 3);
+    assert(after.bfs_ids(a).size() == 4 && after.label(d) == 40);
+    assert(after.version_number() > before.version_number());
+
+    assert(V.add_edge(a, b) == false);   //already there
+    assert(V.add_edge(a, 7) == false && V.add_edge(-1, a) == false);
+    assert(V.read().count_edge() == 3);
+
+    uint64_t last = V.read().version_number();
+    V.compact();
+    assert(V.read().version_number() == last && V.read().count_edge() == 3);   //compaction changes no version
+    assert(before.has_edge(b, c) == false && before.count_edge() == 1);
+    int e = V.add_node(50);
+    assert(V.read().version_number() > last && V.read().label(e) == 50);
+
+    versioned_graph<int, false> U(0);   //undirected, both ends see the edge
+    int x = U.add_node(1), y = U.add_node(2);
+    assert(U.add_edge(x, y) == true && U.add_edge(y, x) == false);
+    assert(U.read().has_edge(y, x) == true && U.read().count_edge() == 1);
+}
+
+
+void test_case_2()  //same answers as a graph with the same edges, before and after compaction
+{
+    const int n = 500;
+    std::mt19937 random_generator(21);
+    graph<int, false, true, int> G;
+    std::vector<int> v(n);
+    for (int i = 0; i < n; i++)
+    {
+        v[i] = i;
+    }
+    G.add_node(v);
+    std::cout.setstate(std::ios::failbit);  //repeated edges are reported by add_edge
+    for (int k = 0; k < 2 * n; k++)
+    {
+        int a = random_generator() % n, b = random_generator() % n;
+        G.add_edge(v[a], v[b], 1 + (a + b) % 20);
+    }
+    std::cout.clear();
+    versioned_graph<int, false, true, int> V(G, 0);
+    assert(V.read().count_edge() == G.count_edge() && V.delta_edges() == 0);
+
+    std::function<int(int)> get_weight = [](int x)
+    {
+        return x;
+    };
+    auto check = [&](const versioned_graph<int, false, true, int>::snapshot &s)
+    {
+        assert(s.count_edge() == G.count_edge());
+        for (int src = 0; src < n; src += 41)
+        {
+            assert(distances(s.bfs_ids(src), n) == distances(G.bfs_ids(v[src]), n));
+            auto a = s.single_source_shortest_path_ids(src, get_weight);
+            auto b = G.single_source_shortest_path_ids(v[src], get_weight);
+            assert(distances(a, n) == distances(b, n));
+        }
+    };
+    check(V.read());
+
+    auto old = V.read();
+    auto old_order = distances(old.bfs_ids(0), n);
+    size_t old_edges = old.count_edge();
+    std::cout.setstate(std::ios::failbit);
+    for (int k = 0; k < n; k++)
+    {
+        int a = random_generator() % n, b = random_generator() % n;
+        bool is_new = (V.read().has_edge(a, b) == false);
+        assert(V.add_edge(a, b, 3) == is_new);
+        G.add_edge(v[a], v[b], 3);
+    }
+    std::cout.clear();
+    assert(V.delta_edges() > 0);
+    check(V.read());
+    V.compact();
+    assert(V.delta_edges() == 0);
+    check(V.read());
+    assert(old.count_edge() == old_edges && distances(old.bfs_ids(0), n) == old_order);     //still reads the old base and delta
+}
+
+
+void test_case_3()  //readers next to a writer, with background compactions in between
+{
+    const int n = 2000;
+    versioned_graph<int, true, true, int> V(0.05);
+    for (int i = 0; i < n; i++)
+    {
+        V.add_node(i);
+    }
+    std::atomic<bool> is_done{ false };
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; t++)
+    {
+        readers.emplace_back([&, t]()
+            {
+                uint64_t last = 0;
+                while (is_done.load() == false)
+                {
+                    auto s = V.read();
+                    assert(s.version_number() >= last);     //also across compactions
+                    last = s.version_number();
+                    size_t edges = 0;
+                    for (int i = 0; i < int(s.count_node()); i++)
+                    {
+                        s.for_each_neighbour(i, [&](int j, const int &w)
+                            {
+                                assert(j == (i * 7 + w) % n);
+                                edges++;
+                            });
+                    }
+                    assert(edges == s.count_edge());   //a snapshot is never torn
+                    assert(s.bfs_ids(t).size() <= s.count_node());
+                }
+            });
+    }
+    std::mt19937 random_generator(22);
+    int added = 0;
+    for (int k = 0; k < 12000; k++)
+    {
+        int i = random_generator() % n, w = 1 + random_generator() % 50;
+        added += V.add_edge(i, (i * 7 + w) % n, w);
+    }
+    is_done.store(true);
+    for (auto &x : readers)
+    {
+        x.join();
+    }
+    assert(V.read().count_edge() == size_t(added));
+    while (V.delta_edges() == size_t(added))    //a compaction was started, wait until it is in
+    {
+        std::this_thread::yield();
+    }
+    assert(V.read().version_number() == uint64_t(n + added));  //one version for every write
+}
+
+
+void run_test()
+{
+    test_case_1();
+    test_case_2();
+    test_case_3();
+}
+
+int main()
+{
+    run_test();
+
+    return 0;
+}
@@ -3,14 +3,32 @@
 #define GRAPH_LIBRARY_H
 
 #include <map>
+#include <set> //for the edge lookup of graphs without edge data
 #include <vector>
 #include <utility> //for using pairs
 #include <cstdint> // for fixed sized integers
 #include <functional> //for using std::function
+#include <atomic> //for the lock free disjoint set union
+#include <mutex> //for the arena of adjacency rows
+#include <type_traits> //for std::conditional
+#include <limits> //for the largest value of an index type
+#include <string> //for the path of a snapshot
+#include <memory> //for sharing a mapped snapshot between copies of a graph
+#include <thread> //for the background compaction of a versioned graph
+#include <deque> //for the tasks given to a thread pool from outside
+#include <condition_variable> //for the idle workers of a thread pool
+#include <future> //for the results of a query engine
 
 
 
 #define INF 4e18 //infinity for comparison purposes in Dijkstra and Bellman Ford
+#define DENSE_GRAPH_THRESHOLD 0.25  //fraction of all possible edges above which Prim's algorithm switches to the O(V^2) version
+#define REACHABILITY_MEMORY_BUDGET (64 << 20)   //default bytes a reachability index may use for its labels
+#define SNAPSHOT_VERSION 1  //written by save, load refuses files of any other version
+#define EXTERNAL_MEMORY_BUDGET (64 << 20)   //default bytes of edges an external graph holds in memory, and the size of one shard
+#define VERSIONED_COMPACTION_THRESHOLD 0.125    //edges added since the base, as a fraction of its edges, which start a background compaction
+#define QUERY_ENGINE_CAPACITY 4096  //default queries a query engine holds before submitting waits
+#define QUERY_ENGINE_BATCH 32  //most searches one task of a query engine runs before it goes back to the pool
 
 
 template<typename K,typename V> // <key, value> pair
@@ -20,21 +38,375 @@ class gmap
 		std::map<K*, V> mp;
 	public:
 		V& operator[](K&);  //remember why (const K&) didn't work
-		const bool ispresent(K&);
+		const bool ispresent(const K&) const;
+		const V* find(const K&) const;  //nullptr if the key is not there, unlike operator[] it never inserts
+		void erase(K&);
+		void for_each_value(const std::function<void(V&)>&);   //used to renumber the values in place
+		void remap_keys(K*, K*, const std::function<K*(K*)>&);  //moves every key inside the range to a new address
 };
 
 template<bool is_integral> struct get_data_type; //for getting which data type to be used for calculations in edge weights
 
+template<typename I = int>  //I is the type of the node indices, uint32_t halves the memory of 64 bit indices
 class disjoint_set_union    //required for krushkal algorithm
 {
     private:
-        std::vector<int> parent, size;
+        std::vector<I> parent, size;
     public:
-        disjoint_set_union(int);
-        const bool is_same(int,int);
-        int find_size(int);
-        int find_parent(int);
-        void do_union(int,int);
+        disjoint_set_union(I);
+        const bool is_same(I,I);
+        I find_size(I);
+        I find_parent(I);
+        bool do_union(I,I);     //returns false if both were already in the same set
+};
+
+template<typename I = int>
+class concurrent_disjoint_set_union     //lock free, for parallel algorithms. Any number of threads can call every function at once
+{
+    private:
+        std::vector<std::atomic<I> > parent;
+    public:
+        concurrent_disjoint_set_union(I);
+        bool is_same(I,I);
+        I find_parent(I);
+        bool do_union(I,I);     //returns true only for the one call which actually joined the two sets
+};
+
+template<typename T>
+class work_stealing_deque   //Chase-Lev deque of task pointers, the owner works at the bottom and any thread steals from the top
+{
+    private:
+        struct ring
+        {
+            int64_t capacity;
+            std::unique_ptr<std::atomic<T*>[]> items;
+            ring(int64_t);
+            T* get(int64_t) const;
+            void put(int64_t, T*);
+        };
+        std::atomic<int64_t> top{ 0 }, bottom{ 0 };
+        std::atomic<ring*> array;
+        std::vector<std::unique_ptr<ring> > rings;  //outgrown rings stay until the deque is gone, a thief may still be reading one
+    public:
+        work_stealing_deque();
+        work_stealing_deque(const work_stealing_deque&) = delete;
+        work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+        void push(T*);      //owner only
+        T* pop();           //owner only, nullptr if empty
+        T* steal();         //any thread, nullptr if empty or another thread took the same task
+        bool empty() const;
+};
+
+/*
+    Work stealing pool shared by the parallel algorithms, so they never start threads of their own. Every worker
+    has its own deque, takes new work from its bottom and, once it runs dry, steals from the top of the others.
+    Tasks given by threads outside the pool wait in one shared queue. A thread waiting for its parallel_for runs
+    other tasks meanwhile, so parallel_for may be called from inside a task. Read more at
+    https://en.wikipedia.org/wiki/Work_stealing
+*/
+
+class thread_pool
+{
+    private:
+        struct task
+        {
+            std::function<void()> work;
+        };
+        struct worker_context
+        {
+            thread_pool *pool;
+            int index;
+        };
+        struct parallel_job                         //one call of parallel_for, lives on the stack of its caller
+        {
+            const std::function<void(int, size_t, size_t)> *work;
+            size_t grain;
+            std::atomic<size_t> pending{ 1 };       //tasks of the job not finished yet
+            std::atomic<int> number_of_free{ 0 };
+            std::vector<int> free_slots;            //thread numbers not held by a running task
+            std::mutex slot_lock;
+            int take_slot();                        //-1 if all are in use
+            void release_slot(int);
+        };
+        std::vector<std::unique_ptr<work_stealing_deque<task> > > deques;
+        std::vector<std::thread> workers;
+        std::deque<task*> injected;                 //tasks from threads outside the pool
+        std::atomic<size_t> number_of_injected{ 0 };
+        std::mutex lock;
+        std::condition_variable wake;
+        std::atomic<uint64_t> epoch{ 0 };           //goes up whenever there is a new task or a job is done
+        std::atomic<int> sleeping{ 0 };
+        std::atomic<bool> is_stopping{ false };
+        static worker_context& context();           //pool and worker of the calling thread, a null pool outside every pool
+        void push(task*);
+        task* find_task(int);
+        static void run(task*);
+        void signal();
+        void wait_for(uint64_t, const std::function<bool()>&);
+        void run_worker(int);
+        void run_range(parallel_job&, size_t, size_t, int);
+    public:
+        explicit thread_pool(int number_of_threads = 0);    //0 or less means one worker per core
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+        ~thread_pool();                             //runs the tasks still queued, then stops the workers
+        int size() const;
+        int own_index();                            //index of the calling worker in this pool, -1 for any other thread
+        void submit(std::function<void()>);         //runs the function on some worker later
+        /*
+            Calls work(t, begin, end) on pieces covering [0, size) and returns once all are done, the caller takes
+            part. At most number_of_threads pieces run at once and t, below number_of_threads, is never used by two
+            of them at the same time, so it can pick per thread scratch. A piece is split in half only when the
+            thread running it has nothing queued, so idle threads get work and busy ones never pay for splitting.
+        */
+        void parallel_for(size_t, int number_of_threads, size_t grain, const std::function<void(int, size_t, size_t)>&);
+        static thread_pool& shared();               //the pool of the library, started on first use with one worker per core
+};
+
+struct execution_policy     //how a parallel algorithm runs, made from a bare thread count too so older calls keep working
+{
+    int number_of_threads = 0;      //0 or less means one per worker of the pool, 1 runs on the calling thread alone
+    thread_pool *pool = nullptr;    //nullptr means thread_pool::shared()
+    size_t grain = 0;               //smallest piece of a parallel_for, 0 picks it from the size
+    execution_policy(int number_of_threads = 0, thread_pool *pool = nullptr, size_t grain = 0);
+    int threads() const;
+};
+
+template<typename I = int, typename O = int64_t>   //I for node and component ids, O for offsets into the edges
+class reachability_index    //answers u -> v reachability on the condensation of a directed graph
+{
+    private:
+        std::vector<I> component;                   //node -> component, ids in reverse topological order
+        std::vector<O> first;                       //condensation in CSR form, next[first[c] .. first[c+1]) are successors of c
+        std::vector<I> next;
+        I number_of_components;
+        size_t words_per_row;
+        std::vector<uint64_t> closure;              //bitset transitive closure, used when it fits in the memory budget
+        int dimensions;
+        std::vector<I> low, post;                   //GRAIL interval labels, dimensions entries per component
+        std::vector<uint32_t> stamp;                //scratch for the pruned search when the labels cannot decide
+        uint32_t current_stamp;
+        bool contains(I, I);                        //every interval of first component contains that of the second
+    public:
+        reachability_index();
+        void build(std::vector<I>, I, std::vector<O>, std::vector<I>, size_t memory_budget = REACHABILITY_MEMORY_BUDGET);
+        bool reachable(I, I);
+        size_t memory_usage();
+};
+
+template<typename I = int, typename O = int64_t>
+class compressed_adjacency  //read only rows of sorted ids, each id stored as the gap from the one before it in as few bytes as it needs
+{
+    private:
+        std::vector<uint8_t> bytes;
+        std::vector<O> first;                       //row i is bytes[first[i] .. first[i+1]), starting with its length
+        const uint8_t *byte_data = nullptr;         //either the two vectors above or a mapped snapshot
+        const O *first_data = nullptr;
+        I number_of_rows = 0;
+        std::shared_ptr<const void> mapping;        //keeps the snapshot mapped while any copy points into it
+        static void append(std::vector<uint8_t>&, uint64_t);
+        static uint64_t read(const uint8_t*&);
+        static bool read_within(const uint8_t*&, const uint8_t*, uint64_t&);    //false instead of reading past the end
+    public:
+        compressed_adjacency() = default;
+        compressed_adjacency(const compressed_adjacency&);
+        compressed_adjacency(compressed_adjacency&&) = default;
+        compressed_adjacency& operator=(const compressed_adjacency&);
+        compressed_adjacency& operator=(compressed_adjacency&&) = default;
+        class row
+        {
+            private:
+                const uint8_t *data;
+                I source, count;
+            public:
+                class iterator
+                {
+                    private:
+                        const uint8_t *data;
+                        I remaining, value;
+                    public:
+                        iterator(const uint8_t*, I, I);
+                        I operator*() const;
+                        iterator& operator++();
+                        bool operator!=(const iterator&) const;
+                };
+                row(const uint8_t*, I, I);
+                iterator begin() const;
+                iterator end() const;
+                size_t size() const;
+                bool empty() const;
+        };
+        template<typename R>
+            void build(const std::vector<R>&);      //every row must already be sorted
+        void attach(std::shared_ptr<const void>, const O*, I, const uint8_t*);   //rows kept in memory owned by someone else
+        bool is_well_formed() const;                //offsets go up and every row decodes inside its own bytes to ids of rows, for attached rows
+        row operator[](I) const;
+        I size() const;
+        size_t memory_usage() const;
+        const O* row_offsets() const;               //size() + 1 entries
+        const uint8_t* row_bytes() const;
+};
+
+struct snapshot_header     //start of a file written by save, every section after it begins at a multiple of 8 bytes
+{
+    char magic[8];
+    uint32_t version, byte_order;
+    uint8_t is_directed, is_weighted, index_size, offset_size;
+    uint32_t edge_size, label_size;                 //label_size is 0 for std::string labels
+    uint64_t nodes, edges, row_bytes, payload_entries, label_bytes;
+};
+
+template<typename T, typename I = int>
+class link_cut_tree     //dynamic forest with the heaviest edge on a path, edges are nodes of their own carrying the weight
+{
+    private:
+        std::vector<I> left, right, parent, heaviest;   //I(-1) means none
+        std::vector<bool> is_reversed, has_weight;
+        std::vector<T> value;
+        static constexpr I none = I(-1);
+        bool is_splay_root(I);
+        void push_down(I);
+        void pull_up(I);
+        void rotate(I);
+        void splay(I);
+        void access(I);
+        void make_root(I);
+    public:
+        I add_node(bool is_edge = false, T weight = T());    //returns the id of the new node
+        I find_root(I);
+        bool is_connected(I, I);
+        void link(I, I);
+        void cut(I, I);
+        I path_maximum(I, I);   //none if the path has no edge
+        T weight(I);
+        void reset_node(I, T);
+};
+
+template<typename T>
+class row_arena     //overflow chunks of adjacency rows, one arena per element type shared by every graph
+{
+    private:
+        std::vector<void*> blocks;
+        T *current = nullptr;
+        size_t used = 0, block_size = 0;            //in elements
+        std::vector<T*> free_chunks[32];            //free_chunks[l] holds released chunks of 2^l elements
+        std::mutex lock;
+        size_t reserved = 0;
+        row_arena() = default;
+    public:
+        static row_arena& instance();
+        T* allocate(unsigned);                      //chunk of 2^l elements
+        void deallocate(T*, unsigned);
+        size_t reserved_bytes();                    //memory taken from the system so far
+};
+
+template<typename T, unsigned K>
+class small_row     //keeps the first K entries inline and only goes to the arena when the row grows past them
+{
+    private:
+        uint32_t count = 0, capacity = K;
+        union
+        {
+            T *heap;
+            alignas(T) unsigned char local[K * sizeof(T)];
+        };
+        T* items();
+        const T* items() const;
+        void relocate(uint32_t);
+        void take(small_row&);
+        void release();
+    public:
+        small_row();
+        small_row(const small_row&);
+        small_row(small_row&&);
+        small_row& operator=(const small_row&);
+        small_row& operator=(small_row&&);
+        ~small_row();
+        size_t size() const;
+        bool empty() const;
+        T* begin();
+        T* end();
+        const T* begin() const;
+        const T* end() const;
+        T& operator[](size_t);
+        const T& operator[](size_t) const;
+        T& back();
+        void push_back(const T&);
+        void push_back(T&&);
+        void pop_back();
+        void clear();
+        void reserve(size_t);
+        void shrink_to_fit();
+        void swap(small_row&);
+        using value_type = T;
+};
+
+/*
+    A storage policy chooses the container of the adjacency rows and the width of the indices.
+    index_type holds node ids (and so every node count, component id and hop distance), offset_type holds
+    edge counts and positions in edge lists. uint32_t ids with int64_t offsets hold 4 billion nodes and any
+    number of edges while keeping every adjacency entry 4 bytes. Unsigned index types use index_type(-1)
+    as "no node", so they must be at least as wide as int.
+*/
+
+template<typename I = int, typename O = int64_t>
+struct vector_storage   //every row is a std::vector, the default
+{
+    using index_type = I;
+    using offset_type = O;
+    template<typename T>
+        using row = std::vector<T>;
+};
+
+template<unsigned K = 3, typename I = int, typename O = int64_t>
+struct pooled_storage   //small rows with K inline entries, longer rows in arena chunks
+{
+    using index_type = I;
+    using offset_type = O;
+    template<typename T>
+        using row = small_row<T, K>;
+};
+
+struct no_edge      //what the edge functions see on a graph declared with E = void
+{
+};
+
+class empty_row     //payload row of a graph without edge data, nothing is stored for any edge
+{
+    private:
+        no_edge value;
+    public:
+        no_edge& operator[](size_t);
+        no_edge& back();
+        void push_back(const no_edge&);
+        void pop_back();
+        void shrink_to_fit();
+        void swap(empty_row&);
+};
+
+/*
+    E = void gives a graph which stores bare neighbour ids: the payload rows are empty_row and the edge lookup
+    is a set of node pairs instead of a map, and add_edge(u, v) is the only way to add an edge.
+*/
+
+template<typename E>
+struct edge_traits
+{
+    using type = E;
+    template<typename S>
+        using row = typename S::template row<E>;
+    template<typename K>
+        using lookup = std::map<K, E>;
+};
+
+template<>
+struct edge_traits<void>
+{
+    using type = no_edge;
+    template<typename S>
+        using row = empty_row;
+    template<typename K>
+        using lookup = std::set<K>;
 };
 
 template<typename N, typename T>
@@ -59,6 +431,93 @@ struct node_pair
 };
 
 
+template<typename R, typename O = int64_t>
+class traversal_range    //lazy bfs or dfs over the plain or the compressed rows of a graph, the next node is only found when the iterator moves
+{
+    private:
+        using I = typename R::value_type;   //index type of the graph
+        const std::vector<R> *adj = nullptr;                //exactly one of the two is set
+        const compressed_adjacency<I, O> *compressed = nullptr;
+        bool is_breadth_first;
+        I depth;
+        std::vector<I> frontier;            //queue for bfs (read from head), stack of (node, parent) pairs for dfs
+        size_t head = 0;
+        std::vector<char> is_visited;
+        std::vector<I> distance;
+        traversal<I, I> current;
+        bool is_expanded = true, is_finished = false;
+        void start(I);
+        template<typename Row>
+            void expand(I, const Row&);     //queues or pushes the neighbours of the node not seen yet
+        void advance();
+    public:
+        class iterator
+        {
+            private:
+                traversal_range *range;
+            public:
+                iterator(traversal_range*);
+                const traversal<I, I>& operator*() const;
+                const traversal<I, I>* operator->() const;
+                iterator& operator++();
+                bool operator!=(const iterator&) const;
+        };
+        traversal_range(const std::vector<R>&, I, bool, I);    //a source of I(-1) gives an empty range
+        traversal_range(const compressed_adjacency<I, O>&, I, bool, I);     //a frozen graph, read without thawing
+        iterator begin();
+        iterator end();
+        void skip();    //the neighbours of the current node are not explored
+};
+
+
+enum class traversal_action    //returned by the visitors of bfs and dfs
+{
+    CONTINUE,
+    SKIP,   //for a node do not explore its neighbours, for an edge do not follow it
+    STOP    //end the search right away
+};
+
+
+enum class merge_policy    //how parallel edges between the same pair of components are combined in condensation
+{
+    MIN,    //keep the lightest edge
+    SUM,    //add the weights of all edges
+    COUNT   //weight is the number of edges merged
+};
+
+
+template<typename G, typename I>
+struct condensation_result     //returned by condensation, an aggregate so the graph is moved in and never assigned
+{
+    G dag;                      //one node per component, labelled by the component id
+    std::vector<I> component;   //component of every node, -1 for a removed node
+};
+
+
+enum class components_algorithm
+{
+    UNION_FIND, //sequential, one union per edge
+    AFFOREST    //parallel, links a sample of the edges first and skips the largest component afterwards
+};
+
+
+enum class edge_list_format    //text formats read by read_edge_list
+{
+    SNAP,           //"u v" or "u v w" on every line, lines starting with # or % are comments, ids are any integers
+    MATRIX_MARKET,  //coordinate .mtx, 1 based, pattern, integer or real values, general or symmetric
+    DIMACS          //shortest path .gr, "p sp n m" and then "a u v w" for every arc, 1 based
+};
+
+
+enum class reorder_strategy    //how reorder renumbers the nodes, every one puts nodes used together close in memory
+{
+    DEGREE,     //highest degree first, so the hubs share a few cache lines
+    BFS,        //breadth first order, restarting from the lowest id not yet placed
+    RCM,        //reverse Cuthill-McKee, keeps the ids at the two ends of every edge close
+    GORDER      //greedy window, places next the node sharing the most neighbours with the last few placed
+};
+
+
 template<typename N,typename E>
 struct full_edge
 {
@@ -67,7 +526,71 @@ struct full_edge
 };
 
 
-template<typename N, typename E>
+template<typename I, typename E>
+struct edge_record      //one edge as it is written in the files of an external graph
+{
+    I from, to;
+    E edge;
+};
+
+template<typename I>
+struct edge_record<I, void>
+{
+    I from, to;
+};
+
+/*
+    Semi-external graph on the dense ids 0 .. n-1, for graphs whose edges do not fit in memory even compressed.
+    Only O(V) state is kept in memory (distances, disjoint set union, ranks, degrees), the edges are in files inside
+    the given directory, sorted by (from, to) and cut into shards which each hold a range of sources. Every
+    algorithm is a number of sequential passes over the shards. An undirected edge is stored in both directions.
+    The files belong to the object and are deleted with it.
+*/
+
+template<typename E = void, typename I = int, typename O = int64_t>   //E must be trivially copyable
+class external_graph
+{
+    public:
+        using edge_type = typename edge_traits<E>::type;
+        using record = edge_record<I, E>;
+    private:
+        std::string directory;
+        std::string prefix;                         //unique to this graph, starts the name of every file it writes
+        I n;
+        O e = 0;
+        bool is_directed;
+        size_t memory_budget;
+        std::vector<record> buffer;                 //edges added since the last run was written
+        std::vector<std::string> runs;              //sorted files which are not merged into the shards yet
+        std::vector<std::string> shards;
+        std::vector<I> shard_first;                 //smallest source of every shard, the shards are in increasing order
+        std::vector<O> degree;                      //outgoing edges of every node
+        size_t file_count = 0;
+        std::string file_name(const char*);
+        void write_run();
+        void seal();                                //merges the runs into new shards, called by every algorithm
+        void scan(size_t, const std::function<void(const record&)>&);
+        static edge_type edge_of(const record&);
+    public:
+        external_graph(const std::string&, I, bool, size_t memory_budget = EXTERNAL_MEMORY_BUDGET);
+        external_graph(const external_graph&) = delete;
+        external_graph& operator=(const external_graph&) = delete;
+        ~external_graph();
+        void add_edge(I, I, edge_type);             //a repeated edge is dropped when the shards are merged
+        void add_edge(I, I);
+        I count_node();
+        O count_edge();
+        size_t count_shard();
+        void for_each_edge(const std::function<void(I, I, const edge_type&)>&);    //one pass in order of (from, to)
+        std::vector<traversal<I, I> > bfs_ids(I);   //one pass per level, skipping shards with no node of the frontier
+        std::vector<I> connected_components();      //one pass through a disjoint set union, edges taken as undirected
+        template<typename T>
+            auto krushkal_minimum_spanning_tree(const std::function<T(edge_type)>&);   //external sort by weight, then one pass
+        std::vector<double> page_rank(int iterations = 20, double damping = 0.85);  //one pass per iteration
+};
+
+
+template<typename N, typename E, typename S = vector_storage<> >
 class Base
 {
 private:
@@ -85,28 +608,143 @@ private:
     // Base(Base&&) = delete;
     // ~Base() = delete;
     // Commented for checking purposes
+
+    template<typename, typename, typename> friend class Directed_Graph;  //condensation builds a new graph directly from its internals
+    template<typename, typename, typename, typename> friend class incremental_minimum_spanning_forest;
+    template<typename, bool, bool, typename, typename> friend class versioned_graph;   //reads the frozen rows of its base and builds the next one
+    template<typename, bool, bool, typename, typename, typename> friend class query_engine;    //searches the rows with workspaces of its own
 protected:
-    gmap<N, int> idx;
-    std::map<int, N> node;
-    int n, e;
-    std::map<std::pair<int,int>, E> get_edge;   
-    std::vector<std::vector<std::pair<int, E> > > adj;
-    bool is_weighted, is_directed;  //will get value from main graph class from template arguments
-    std::vector<traversal<N,int32_t> > breadth_first_search_by_index(int, bool is_for_sssp, int depth = INT32_MAX);
+    using index_type = typename S::index_type;
+    using offset_type = typename S::offset_type;
+    static constexpr index_type no_depth_limit = std::numeric_limits<index_type>::max();
+    gmap<N, index_type> idx;    //keyed by the copy in node and, for nodes from add_node, by the caller's label too
+    std::vector<N> node;    //label of every dense index, slots of removed nodes keep a stale label
+    std::vector<N*> added_as;   //the label add_node was given, the second key of idx, nullptr for labels the graph owns
+    index_type n = 0;
+    offset_type e = 0;
+    using edge_type = typename edge_traits<E>::type;     //E itself, or no_edge when E is void
+    using edge_lookup = typename edge_traits<E>::template lookup<std::pair<index_type, index_type> >;
+    edge_lookup get_edge;
+    void record_edge(edge_lookup&, index_type, index_type, const edge_type&);
+    /*
+        Structure of arrays, adj[i][k] is the target of an edge and payload[i][k] the edge itself. Traversals, scc,
+        topo_sort and the like only read the targets, so the edges never come through the cache for them.
+    */
+    using row_type = typename S::template row<index_type>;
+    using payload_row = typename edge_traits<E>::template row<S>;
+    std::vector<row_type> adj;
+    std::vector<payload_row> payload;
+    std::vector<row_type> radj; //sources of incoming edges, only kept for directed graphs once enabled
+    bool has_reverse_adjacency = false;
+    std::vector<bool> is_removed;   //tombstones, removed node indices stay unused until reused by add_node or compact
+    std::vector<index_type> free_slots;
+    index_type number_of_removed = 0;
+    size_t mutation_count = 0;      //goes up whenever a node or an edge is added or removed or the ids move, so indices built on the graph know they are stale
+    /*
+        While frozen the targets live only in compressed and adj, radj and get_edge are empty, the edges stay in
+        payload in the order of the sorted rows. Traversals, scc, topo_sort and the components read the compressed
+        rows directly, everything else calls thaw first. A loaded snapshot leaves payload empty and reads the edges
+        in place from the file until it thaws, so the edge functions read through edge_at.
+    */
+    compressed_adjacency<index_type, offset_type> compressed;
+    bool is_frozen = false;
+    const edge_type *mapped_edges = nullptr;    //edges of a loaded snapshot, kept alive by the mapping of compressed
+    std::vector<offset_type> mapped_first;      //row i has mapped_edges[mapped_first[i] .. mapped_first[i+1])
+    const edge_type& edge_at(index_type, size_t) const;    //payload[i][k], never for E = void
+    size_t edges_in_row(index_type) const;
+    void thaw();
+    bool remove_from_row(row_type&, index_type, payload_row* = nullptr);  //swap and pop the first entry going to the node, and its edge
+    void insert_edge(index_type, index_type, const edge_type&);  //the edge must not be present yet
+    void assign_nodes(std::vector<N>&&);    //only on an empty graph
+    bool is_weighted = false, is_directed = false;  //will get value from main graph class from template arguments
+    template<bool as_ids>
+        using label_type = typename std::conditional<as_ids, index_type, N>::type;    //results hold either dense ids or copies of the labels
+    template<bool as_ids>
+        label_type<as_ids> label_or_id(index_type) const;
+    template<bool as_ids>
+        std::vector<traversal<label_type<as_ids>, index_type> > breadth_first_search_by_index(index_type, bool is_for_sssp, index_type depth = no_depth_limit) const;
+    template<bool as_ids, typename R>
+        std::vector<traversal<label_type<as_ids>, index_type> > breadth_first_search_by_index(const R&, index_type, bool, index_type) const;   //R is adj or compressed
+    template<bool as_ids>
+        std::vector<traversal<label_type<as_ids>, index_type> > depth_first_search_by_index(index_type, index_type depth = no_depth_limit) const;
+    template<bool as_ids, typename R>
+        std::vector<traversal<label_type<as_ids>, index_type> > depth_first_search_by_index(const R&, index_type, index_type) const;
+    template<bool breadth_first, typename R>
+        bool visit_by_index(const R&, index_type, const std::function<traversal_action(N&, N&, index_type)>&, const std::function<traversal_action(N&, N&, const edge_type&)>&);
+    index_type connected_components_by_index(std::vector<index_type>&, components_algorithm, const execution_policy&) const;   //edges taken as undirected, returns number of components
+    template<typename R>
+        index_type connected_components_by_index(const R&, std::vector<index_type>&, components_algorithm, const execution_policy&) const;
+    std::vector<index_type> vertex_order(reorder_strategy);     //old ids in their new order
+    void renumber(const std::vector<index_type>&);               //moves every id i to new_index[i], a permutation
 public:
-    size_t count_node();
-    size_t count_edge();
+    /*
+        Functions marked const are the read path: they never change the graph, look labels up without inserting
+        and keep all their scratch inside the call, so any number of threads may call them on one graph at the same
+        time, frozen or not, as long as no thread changes it meanwhile. Everything else, including the functions
+        which thaw, enable the reverse adjacency or build an index on first use, needs the graph to itself.
+    */
+    size_t count_node() const;
+    size_t count_edge() const;
     void add_node( N& );
     void add_node( std::vector<N>& );
     /*
-        This 1 has been added to ensure that in case of unweighted graph and user tries to insert using (N&, N&) it works.
-        Remember that it works only when user donot specify a specific data type for Edges.
+        The two argument version uses an edge of 1, so that in case of unweighted graph the user can insert using (N&, N&).
+        Remember that it works only when the edge type can be made from 1, or is void.
+    */
+    void add_edge(N&, N&, edge_type);
+    void add_edge(N&, N&);
+    void add_edges(const std::vector<std::pair<index_type, index_type> >&, const std::vector<edge_type>& = {}, const execution_policy& = {});   //bulk add_edge on dense ids, edges[k] for the k-th pair or all 1 if empty
+    /*
+        Reads a text edge list into an empty graph. The file is mapped and split at line boundaries, every chunk is
+        parsed by its own thread and the edges then go through add_edges. Labels are the ids of the file converted
+        to N, a loaded graph keeps them itself so reach them through label(). Weights go into the edges when E can
+        be made from a double. Returns false and adds nothing if the file cannot be read or has a line which is
+        not an edge.
+    */
+    bool read_edge_list(const std::string&, edge_list_format, const execution_policy& = {});
+    void enable_reverse_adjacency();    //opt-in, costs one more row per node and one more entry per edge
+    void remove_node(N&);
+    void remove_edge(N&, N&);
+    void compact();     //renumbers the nodes densely and releases the memory of removed nodes and edges
+    void reorder(reorder_strategy = reorder_strategy::RCM);    //compacts, then renumbers the dense ids so that traversals stay in cache
+    /*
+        Sorts every row and keeps it gap coded, and drops the per edge lookup and the reverse adjacency, so the graph
+        takes a few bytes per edge. Any change, or any algorithm which needs more than the targets, thaws it again.
+    */
+    void freeze();
+    bool frozen() const;
+    size_t adjacency_bytes() const;   //memory of the targets, compressed or not
+    /*
+        Binary snapshot with the compressed rows, the edges and the labels. E must be trivially copyable, N trivially
+        copyable or std::string. save compacts and freezes the graph first. load only works on an empty graph, it maps
+        the file and the graph stays frozen on the mapped rows, so neither the targets nor the edges are copied. Labels of
+        a loaded graph are its own copies, reach them through label() with the same ids as in the saved graph.
     */
-    void add_edge(N&, N&, E = 1 );
-    // void remove_node(N&);
-    // void remove_edge(N&, N&);
-    std::vector<traversal<N,int> > bfs(N&, int depth = INT32_MAX);
-    std::vector<traversal<N,int> > dfs(N&, int depth = INT32_MAX);
+    bool save(const std::string&);
+    bool load(const std::string&);
+    N& label(index_type);   //label of a dense id as returned by the functions ending in _ids, the graph's own copy, can be passed back to any function taking a node
+    const N& label(index_type) const;
+    index_type id(const N&) const;      //dense id of a label, index_type(-1) if it is not in the graph
+    std::vector<traversal<N,index_type> > bfs(const N&, index_type depth = no_depth_limit) const;    //empty if the node is not in the graph
+    std::vector<traversal<N,index_type> > dfs(const N&, index_type depth = no_depth_limit) const;
+    std::vector<traversal<index_type,index_type> > bfs_ids(const N&, index_type depth = no_depth_limit) const;  //same as bfs but with dense ids, no label is copied
+    std::vector<traversal<index_type,index_type> > dfs_ids(const N&, index_type depth = no_depth_limit) const;
+    index_type id(const N&&) const = delete;    //nodes are keyed by address, a temporary is never in the graph
+    std::vector<traversal<N,index_type> > bfs(const N&&, index_type depth = no_depth_limit) const = delete;
+    std::vector<traversal<N,index_type> > dfs(const N&&, index_type depth = no_depth_limit) const = delete;
+    std::vector<traversal<index_type,index_type> > bfs_ids(const N&&, index_type depth = no_depth_limit) const = delete;
+    std::vector<traversal<index_type,index_type> > dfs_ids(const N&&, index_type depth = no_depth_limit) const = delete;
+    /*
+        Streaming versions, nothing is stored for the result. The node visitor is called once for every node when it
+        is discovered and the edge visitor, if given, for every edge leaving an explored node. Both return true if a
+        visitor stopped the search.
+    */
+    using node_visitor = std::function<traversal_action(N&, N&, index_type)>;   //node, parent, depth
+    using edge_visitor = std::function<traversal_action(N&, N&, const edge_type&)>;    //from, to, edge
+    bool bfs(N&, const node_visitor&, const edge_visitor& = nullptr);     //false and nothing visited if the node is not in the graph
+    bool dfs(N&, const node_visitor&, const edge_visitor& = nullptr);
+    traversal_range<row_type, offset_type> bfs_range(N&, index_type depth = no_depth_limit);   //lazy, yields dense ids, empty if the node is not in the graph
+    traversal_range<row_type, offset_type> dfs_range(N&, index_type depth = no_depth_limit);
     /*
         Read more about default arguments in functions
         https://stackoverflow.com/questions/32105975/why-cant-i-have-template-and-default-arguments
@@ -119,40 +757,93 @@ public:
     https://stackoverflow.com/questions/4010281/accessing-protected-members-of-superclass-in-c-with-templates
 */
 
-template<typename N, typename E>
+template<typename N, typename E, typename S = vector_storage<> >
 class Directed_Graph :
-    public virtual Base<N, E>   //try to write different algo for single source shortest path for a DAG
+    public virtual Base<N, E, S>   //try to write different algo for single source shortest path for a DAG
 {
     protected:                  //changed the scope of using. Earlier was in public, so was exposed to the user and can be misused
-        using Base<N, E> :: node;
-        using Base<N, E> :: n;
-        using Base<N, E> :: adj;
-        using Base<N, E> :: is_weighted;
-        using Base<N, E> :: is_directed;
+        using Base<N, E, S> :: idx;
+        using Base<N, E, S> :: node;
+        using Base<N, E, S> :: n;
+        using Base<N, E, S> :: e;
+        using Base<N, E, S> :: adj;
+        using Base<N, E, S> :: payload;
+        using Base<N, E, S> :: is_weighted;
+        using Base<N, E, S> :: is_directed;
+        using Base<N, E, S> :: is_removed;
+        using index_type = typename Base<N, E, S>::index_type;
+        using offset_type = typename Base<N, E, S>::offset_type;
+        using edge_type = typename Base<N, E, S>::edge_type;
+        using Base<N, E, S> :: radj;
+        using Base<N, E, S> :: has_reverse_adjacency;
+        using Base<N, E, S> :: mutation_count;
+
+        reachability_index<index_type, offset_type> reachability;
+        size_t reachability_mutation_count = -1;   //mutation_count of the graph when the index was built, to detect staleness
+        size_t reachability_budget = REACHABILITY_MEMORY_BUDGET;
+
+        template<bool as_ids>
+            using label_type = typename Base<N, E, S>::template label_type<as_ids>;
+
+        using Base<N, E, S> :: compressed;
+        using Base<N, E, S> :: is_frozen;
+
+        index_type strongly_connected_components_by_index(std::vector<index_type>&) const;  //returns number of components, fills node -> component array
+        template<typename R>
+            index_type strongly_connected_components_by_index(const R&, std::vector<index_type>&) const;  //R is adj or compressed
+        template<bool as_ids>
+            auto group_strongly_connected_components() const;
+        std::vector<index_type> topological_order_by_index() const;
+        template<typename R>
+            std::vector<index_type> topological_order_by_index(const R&) const;
+        template<typename R>
+            bool is_dag(const R&) const;
+        void group_by_component(const std::vector<index_type>&, index_type, std::vector<index_type>&, std::vector<index_type>&);
+        template<typename W>
+            void build_condensation(Base<index_type, W, S>&, const std::vector<index_type>&, index_type, const std::function <W(edge_type)>&, merge_policy);
 
     public:
         
         // bool detect_cycle(int, int, std::vector<bool>, std::vector<int>, std::vector<int>);  //some error check once
-        bool is_dag();
-        std::vector<std::vector<N> > scc();
-        std::vector<N> topo_sort();
+        bool is_dag() const;
+        std::vector<std::vector<N> > scc() const;
+        std::vector<N> topo_sort() const;
+        std::vector<std::vector<index_type> > scc_ids() const;     //dense ids instead of labels, see label()
+        std::vector<index_type> topo_sort_ids() const;
+        auto condensation();    //returns { component DAG , node -> component array }, see condensation_result
+        template<typename T>
+            auto condensation(const std::function <T(edge_type)>&, merge_policy = merge_policy::MIN);
+        void build_reachability_index(size_t memory_budget = REACHABILITY_MEMORY_BUDGET);
+        bool reachable(N&, N&);     //builds the index on first use and again after the graph changes
+        std::vector<index_type> weakly_connected_components(components_algorithm = components_algorithm::UNION_FIND, const execution_policy& = {}) const;
+        size_t in_degree(N&);       //both enable the reverse adjacency if it is not already
+        std::vector<N> predecessors(N&);
 };
 
 
 
-template<typename N, typename E>
+template<typename N, typename E, typename S = vector_storage<> >
 class Undirected_Graph:
-    public virtual Base<N, E>
+    public virtual Base<N, E, S>
 {   
      protected:                  //changed the scope of using. Earlier was in public, so was exposed to the user and can be misused
-        using Base<N, E> :: idx;
-        using Base<N, E> :: node;
-        using Base<N, E> :: n;
-        using Base<N, E> :: e;
-        using Base<N, E> :: adj;
-        using Base<N, E> :: get_edge;
-        using Base<N, E> :: is_weighted;
-        using Base<N, E> :: is_directed;
+        using Base<N, E, S> :: idx;
+        using Base<N, E, S> :: node;
+        using Base<N, E, S> :: n;
+        using Base<N, E, S> :: e;
+        using Base<N, E, S> :: adj;
+        using Base<N, E, S> :: payload;
+        using Base<N, E, S> :: get_edge;
+        using Base<N, E, S> :: is_weighted;
+        using Base<N, E, S> :: is_directed;
+        using Base<N, E, S> :: is_removed;
+        using Base<N, E, S> :: number_of_removed;
+        using index_type = typename Base<N, E, S>::index_type;
+        using offset_type = typename Base<N, E, S>::offset_type;
+        using edge_type = typename Base<N, E, S>::edge_type;
+
+        template<typename type, typename F>
+            type dense_prims(std::vector<index_type>&, std::vector<index_type>&, F&&);    //returns total weight, fills order of addition and parent
       
     public:
         /*
@@ -161,51 +852,118 @@ class Undirected_Graph:
             https://stackoverflow.com/questions/44864576/returning-different-type-from-a-function-template-depending-on-a-condition
         */
         template<typename T>
-            auto  prims_minimum_spanning_tree(const std::function <T(E)>&);    //both algorithms works fine with negative edge weights also
+            auto  prims_minimum_spanning_tree(const std::function <T(edge_type)>&);    //both algorithms works fine with negative edge weights also
+        template<typename T>
+            auto dense_prims_minimum_spanning_tree(const std::function <T(N&, N&)>&);  //complete graph with weights given by the function
         template<typename T>
-            auto krushkal_minimum_spanning_tree(const std::function <T(E)>&);
+            auto krushkal_minimum_spanning_tree(const std::function <T(edge_type)>&);
+        template<typename T>
+            auto boruvka_minimum_spanning_tree(const std::function <T(edge_type)>&, const execution_policy& = {});   //a bare thread count works too, 0 means one per core
+        std::vector<index_type> connected_components(components_algorithm = components_algorithm::UNION_FIND, const execution_policy& = {}) const;   //component id of every node, in order of insertion
 };
 
 
-template<typename N,typename E>
+/*
+    Keeps a minimum spanning forest of an undirected graph while edges are added to it.
+    Edges must be added through this object so that it sees every one of them.
+*/
+
+template<typename N, typename E, typename T, typename S = vector_storage<> >
+class incremental_minimum_spanning_forest
+{
+    private:
+        using type = typename get_data_type<std::is_integral<T>::value>::type;
+        using index_type = typename S::index_type;
+        using offset_type = typename S::offset_type;    //ids of the link cut tree, which has a node for every edge too
+        Base<N, E, S> &G;
+        std::function <T(E)> get_weight;
+        link_cut_tree<type, offset_type> forest;    //holds both the nodes of the graph and the edges of the forest
+        std::vector<offset_type> vertex;            //node of the link cut tree for every node of the graph
+        std::vector<index_type> from, to;           //end points of every edge node, as node indices of the graph
+        std::vector<E> payload;
+        std::vector<offset_type> free_edges;        //edge nodes removed from the forest, reused by later edges
+        type total;
+        offset_type number_of_edges;
+        void add_nodes();                           //nodes added to the graph since the last call
+        void insert(index_type, index_type, const E&);
+    public:
+        incremental_minimum_spanning_forest(Undirected_Graph<N, E, S>&, const std::function <T(E)>&);  //starts from the edges already present
+        void add_edge(N&, N&, E = 1);
+        type total_weight();
+        size_t count_edge();
+        std::vector<full_edge<N, E> > edges();
+};
+
+
+template<typename N, typename E, typename S = vector_storage<> >
 class Unweighted_Graph:
-    public virtual Base<N, E>
+    public virtual Base<N, E, S>
 {
      protected:                  //changed the scope of using. Earlier was in public, so was exposed to the user and can be misused
         
-        using Base<N, E> :: idx;
-        using Base<N, E> :: node;
-        using Base<N, E> :: n;
-        using Base<N, E> :: e;
-        using Base<N, E> :: adj;
-        using Base<N, E> :: get_edge;
-        using Base<N, E> :: is_weighted;
-        using Base<N, E> :: is_directed;
+        using Base<N, E, S> :: idx;
+        using Base<N, E, S> :: node;
+        using Base<N, E, S> :: n;
+        using Base<N, E, S> :: e;
+        using Base<N, E, S> :: adj;
+        using Base<N, E, S> :: get_edge;
+        using Base<N, E, S> :: is_weighted;
+        using Base<N, E, S> :: is_directed;
+        using Base<N, E, S> :: is_removed;
+        using index_type = typename Base<N, E, S>::index_type;
+        using offset_type = typename Base<N, E, S>::offset_type;
+        using edge_type = typename Base<N, E, S>::edge_type;
+        template<bool as_ids>
+            using label_type = typename Base<N, E, S>::template label_type<as_ids>;
+
+        template<bool as_ids>
+            auto all_pair_shortest_path_by_index() const;
 
     public:
 
-        std::vector <traversal<N,int> > single_source_shortest_path(N&);
-        std::vector <node_pair<N,int> > all_pair_shortest_path();
+        std::vector <traversal<N,index_type> > single_source_shortest_path(const N&) const;
+        std::vector <node_pair<N,index_type> > all_pair_shortest_path() const;
+        std::vector <traversal<index_type,index_type> > single_source_shortest_path_ids(const N&) const;
+        std::vector <node_pair<index_type,index_type> > all_pair_shortest_path_ids() const;
+        std::vector <traversal<N,index_type> > single_source_shortest_path(const N&&) const = delete;     //a temporary is never in the graph
+        std::vector <traversal<index_type,index_type> > single_source_shortest_path_ids(const N&&) const = delete;
 };
 
-template<typename N, typename E>
+template<typename N, typename E, typename S = vector_storage<> >
 class Weighted_Graph:
-    public virtual Base<N, E>
+    public virtual Base<N, E, S>
 {
+    static_assert(std::is_void<E>::value == false, "A weighted graph needs an edge type, E = void is only for unweighted graphs");
     private:
-        template<typename T>
-            auto dijkstra(int, const std::function <T(E)>& );   //total 2 types of each for float and int
-        template<typename T>
-            auto shortest_path_faster_algorithm(int, bool&, const std::function <T(E)>& );
+        using index_type = typename Base<N, E, S>::index_type;
+        template<bool as_ids>
+            using label_type = typename Base<N, E, S>::template label_type<as_ids>;
+        template<bool as_ids, typename T, typename R>
+            auto dijkstra(const R&, index_type, const std::function <T(E)>& ) const;   //total 2 types of each for float and int, R is adj or compressed
+        template<bool as_ids, typename T, typename R>
+            auto shortest_path_faster_algorithm(const R&, index_type, bool&, const std::function <T(E)>& ) const;
+        template<bool as_ids, typename T>
+            auto single_source_shortest_path_by_index(index_type, const std::function <T(E)>& ) const;
+        template<bool as_ids, typename T>
+            auto all_pair_shortest_path_by_index(const std::function <T(E)>& ) const;
+        template<typename, bool, bool, typename, typename, typename> friend class query_engine;    //runs single_source_shortest_path_by_index on ids it already has
     protected:                  //changed the scope of using. Earlier was in public, so was exposed to the user and can be misused
-        using Base<N, E> :: idx;
-        using Base<N, E> :: node;
-        using Base<N, E> :: n;
-        using Base<N, E> :: e;
-        using Base<N, E> :: adj;
-        using Base<N, E> :: get_edge;
-        using Base<N, E> :: is_weighted;
-        using Base<N, E> :: is_directed;
+        using Base<N, E, S> :: idx;
+        using Base<N, E, S> :: node;
+        using Base<N, E, S> :: n;
+        using Base<N, E, S> :: e;
+        using Base<N, E, S> :: adj;
+        using Base<N, E, S> :: payload;
+        using Base<N, E, S> :: edge_at;
+        using Base<N, E, S> :: edges_in_row;
+        using Base<N, E, S> :: get_edge;
+        using Base<N, E, S> :: is_weighted;
+        using Base<N, E, S> :: is_directed;
+        using Base<N, E, S> :: is_removed;
+        using offset_type = typename Base<N, E, S>::offset_type;
+        using edge_type = typename Base<N, E, S>::edge_type;
+        using Base<N, E, S> :: compressed;
+        using Base<N, E, S> :: is_frozen;
 
     public:
         
@@ -213,35 +971,274 @@ class Weighted_Graph:
         
         
         template<typename T>
-            auto single_source_shortest_path( N&, const std::function <T(E)>& );
+            auto single_source_shortest_path( const N&, const std::function <T(E)>& ) const;   //empty if the node is not in the graph
+        template<typename T>
+            auto all_pair_shortest_path( const std::function <T(E)>& ) const;
+        template<typename T>
+            auto single_source_shortest_path_ids( const N&, const std::function <T(E)>& ) const;  //dense ids instead of labels
+        template<typename T>
+            auto all_pair_shortest_path_ids( const std::function <T(E)>& ) const;
+        template<typename T>
+            bool is_negative_weight_cycle( const N&, const std::function <T(E)>& ) const;
         template<typename T>
-            auto all_pair_shortest_path( const std::function <T(E)>& );
+            void single_source_shortest_path( const N&&, const std::function <T(E)>& ) const = delete;    //a temporary is never in the graph
         template<typename T>
-            bool is_negative_weight_cycle( N&, const std::function <T(E)>& );
+            void single_source_shortest_path_ids( const N&&, const std::function <T(E)>& ) const = delete;
+        template<typename T>
+            bool is_negative_weight_cycle( const N&&, const std::function <T(E)>& ) const = delete;
 
         
 };
 
-template<typename N = int, bool is_directed = 0, bool is_weighted = 0, typename E = int>
+template<typename N = int, bool is_directed = 0, bool is_weighted = 0, typename E = int, typename S = vector_storage<> >
 class graph:
-    public virtual std::conditional<is_directed, Directed_Graph<N,E>, Undirected_Graph<N,E> >::type,
-    public virtual std::conditional<is_weighted, Weighted_Graph<N,E>, Unweighted_Graph<N,E> >::type
+    public virtual std::conditional<is_directed, Directed_Graph<N,E,S>, Undirected_Graph<N,E,S> >::type,
+    public virtual std::conditional<is_weighted, Weighted_Graph<N,E,S>, Unweighted_Graph<N,E,S> >::type
 {
     protected:
-        using Base<N, E> :: idx;
-        using Base<N, E> :: node;
-        using Base<N, E> :: n;
-        using Base<N, E> :: e;
-        using Base<N, E> :: adj;
-        using Base<N, E> :: get_edge;
+        using Base<N, E, S> :: idx;
+        using Base<N, E, S> :: node;
+        using Base<N, E, S> :: n;
+        using Base<N, E, S> :: e;
+        using Base<N, E, S> :: adj;
+        using Base<N, E, S> :: payload;
+        using Base<N, E, S> :: get_edge;
 
     public:
-        graph(int); //Remember to update the superclass base variables
+        graph(size_t); //Remember to update the superclass base variables
         graph();
         
 };
 
 
+template<typename T>
+class append_only_table     //entries never move once written, so readers can use any entry published to them while one writer appends
+{
+    private:
+        static constexpr size_t first_level = 64;   //level k holds first_level << k entries
+        std::atomic<T*> level[48];
+        static void locate(size_t, size_t&, size_t&);
+    public:
+        append_only_table();
+        append_only_table(const append_only_table&) = delete;
+        append_only_table& operator=(const append_only_table&) = delete;
+        ~append_only_table();
+        void reserve(size_t);                       //writer only, makes entries 0 .. size-1 usable
+        T& operator[](size_t) const;
+};
+
+/*
+    Snapshot isolation (MVCC) over a graph, read more at https://en.wikipedia.org/wiki/Multiversion_concurrency_control
+    The graph is an immutable frozen base and a delta of the nodes and edges added after it. One writer at a time
+    appends to the delta and every commit gets the next version number. A reader takes a snapshot, which is only
+    a pointer to the current base and delta and the last committed version, so taking one never waits for a
+    writer and the snapshot keeps seeing exactly that version however much is written meanwhile. When the delta
+    grows past a fraction of the base, a background thread merges both into a new frozen base and the next
+    snapshots use it; older snapshots keep the old base alive until they are gone. Nodes and edges are only
+    added, ids are dense and given in order of addition, the labels are copied.
+*/
+
+template<typename N = int, bool is_directed = 0, bool is_weighted = 0, typename E = int, typename S = vector_storage<> >
+class versioned_graph
+{
+    public:
+        using graph_type = graph<N, is_directed, is_weighted, E, S>;
+        using index_type = typename S::index_type;
+        using offset_type = typename S::offset_type;
+        using edge_type = typename edge_traits<E>::type;
+    private:
+        struct delta_entry
+        {
+            index_type to;
+            edge_type edge;
+            uint64_t version;
+        };
+        struct delta_segment                        //entries of a row are appended to its last segment
+        {
+            std::unique_ptr<delta_entry[]> items;
+            uint32_t capacity = 0;
+            std::atomic<uint32_t> size{ 0 };
+            std::atomic<delta_segment*> next{ nullptr };
+        };
+        struct delta_row
+        {
+            std::atomic<delta_segment*> first{ nullptr };
+            delta_segment *last = nullptr;          //only used by the writer
+        };
+        struct delta_edge
+        {
+            index_type from, to;
+            edge_type edge;
+        };
+        struct counts
+        {
+            index_type nodes;
+            offset_type edges;
+        };
+        struct generation                           //a base and everything written after it
+        {
+            std::shared_ptr<const graph_type> base;
+            index_type base_nodes = 0;
+            offset_type base_edges = 0;
+            append_only_table<N> labels;            //of the nodes added after the base
+            append_only_table<delta_row> rows;
+            append_only_table<delta_edge> log;      //every added edge once, in order, for compaction
+            append_only_table<counts> versions;     //size of the graph at every version from first_version on, which is the base alone
+            uint64_t first_version = 0;             //last version of the generation before, so versions never go back
+            std::atomic<uint64_t> committed{ 0 };
+            index_type reserved_rows = 0;
+            ~generation();
+        };
+        std::shared_ptr<generation> current;
+        std::mutex write_lock, compaction_lock, compactor_lock;
+        std::thread compactor;
+        std::atomic<bool> is_compacting{ false };
+        double compaction_threshold;
+        static std::shared_ptr<const graph_type> build_base(std::vector<N>&&, const std::vector<std::pair<index_type, index_type> >&, const std::vector<edge_type>&);   //frozen
+        static std::shared_ptr<generation> make_generation(std::shared_ptr<const graph_type>, uint64_t first_version);
+        static void append_entry(generation&, index_type, index_type, const edge_type&, uint64_t);
+        static index_type append_node(generation&, counts&, const N&);
+        static void append_edge(generation&, counts&, index_type, index_type, const edge_type&, uint64_t);
+        static void commit(generation&, const counts&, uint64_t);
+    public:
+        class snapshot
+        {
+            private:
+                std::shared_ptr<const generation> state;
+                uint64_t version;
+                counts size;
+                friend class versioned_graph;
+            public:
+                snapshot(std::shared_ptr<const generation>, uint64_t);
+                size_t count_node() const;
+                size_t count_edge() const;
+                uint64_t version_number() const;
+                const N& label(index_type) const;
+                void for_each_neighbour(index_type, const std::function<void(index_type, const edge_type&)>&) const;
+                std::vector<index_type> neighbours(index_type) const;
+                bool has_edge(index_type, index_type) const;
+                std::vector<traversal<index_type, index_type> > bfs_ids(index_type, index_type depth = std::numeric_limits<index_type>::max()) const;
+                template<typename T>
+                    auto single_source_shortest_path_ids(index_type, const std::function<T(edge_type)>&) const;     //Dijkstra, weights must not be negative
+        };
+        versioned_graph(double threshold = VERSIONED_COMPACTION_THRESHOLD);
+        versioned_graph(const graph_type&, double threshold = VERSIONED_COMPACTION_THRESHOLD);    //starts from a copy of the nodes and edges of the graph
+        versioned_graph(const versioned_graph&) = delete;
+        versioned_graph& operator=(const versioned_graph&) = delete;
+        ~versioned_graph();
+        index_type add_node(const N&);              //returns the id of the new node
+        bool add_edge(index_type, index_type, edge_type);  //false if a node is missing or the edge is already there
+        bool add_edge(index_type, index_type);
+        snapshot read() const;                      //the last committed version, never waits
+        void compact();                             //merges the delta into a new frozen base now, readers and writers go on meanwhile
+        size_t delta_edges() const;                 //edges added since the current base
+};
+
+template<typename R>
+class query_future  //result of one query given to a query engine
+{
+    private:
+        std::future<R> value;
+        std::shared_ptr<std::atomic<bool> > is_cancelled;
+    public:
+        query_future(std::future<R>&&, std::shared_ptr<std::atomic<bool> >);
+        R get();                                    //waits, and like std::future only once
+        void wait() const;
+        bool is_ready() const;
+        void cancel();                              //a query which has not finished yet ends with an empty result, it is still waited for as usual
+        std::future<R>& future();
+};
+
+/*
+    Answers many independent queries on one graph from a pool of threads, for servers which get them from many
+    clients at once. Every call returns at once with a query_future. Queries wait in a queue and tasks on the pool
+    take them in batches: identical queries are run once and share the result, and all the point to point queries
+    from one source share a single search which stops when the last of their targets is reached. A task keeps its
+    workspace between searches and marks it with a round number instead of clearing it, so a short search costs
+    only what it touches. At most number_of_threads tasks run at once, and once capacity queries are waiting or
+    running a new call waits for room, so a flood of queries slows the callers down instead of filling memory.
+    A call from a thread of the engine's own pool answers a batch itself instead of waiting, since its sleep could
+    hold up the very tasks which make room. Waiting on a result from such a thread still ties it up, so tasks on
+    the pool should only submit. The graph must not change and must outlive the engine. Results use dense ids, see
+    label() of the graph.
+*/
+
+template<typename N = int, bool is_directed = 0, bool is_weighted = 0, typename E = int, typename S = vector_storage<>, typename T = E>    //T is returned by the weight function
+class query_engine
+{
+    public:
+        using graph_type = graph<N, is_directed, is_weighted, E, S>;
+        using index_type = typename S::index_type;
+        using edge_type = typename edge_traits<E>::type;
+        using distance_type = typename std::conditional<is_weighted, typename get_data_type<std::is_integral<T>::value>::type, index_type>::type;
+        using bfs_result = std::vector<traversal<index_type, index_type> >;
+        using path_result = std::vector<traversal<index_type, distance_type> >;
+    private:
+        enum query_kind { BFS, SHORTEST_PATHS, PATH };
+        template<typename R>
+        struct waiter
+        {
+            std::promise<R> promise;
+            std::shared_ptr<std::atomic<bool> > is_cancelled;
+            index_type target;                      //only for PATH
+        };
+        struct run                                  //one search and every query answered by it
+        {
+            query_kind kind;
+            index_type source, depth;
+            std::vector<waiter<bfs_result> > bfs_waiters;
+            std::vector<waiter<path_result> > path_waiters;
+            bool is_cancelled() const;              //every query of it is cancelled
+        };
+        struct workspace                            //scratch of one task, kept from one search to the next
+        {
+            std::vector<uint32_t> stamp, settled, wanted;   //a node is reached, settled or a target only if its entry equals round
+            uint32_t round = 0;
+            std::vector<distance_type> distance;
+            std::vector<index_type> parent;
+            std::vector<index_type> queue;
+            std::vector<std::pair<distance_type, index_type> > heap;
+            void start(size_t);
+        };
+        const graph_type &G;
+        std::function<T(edge_type)> get_weight;
+        bool is_negative_weight = false;            //checked once, Dijkstra is only used without negative weights
+        thread_pool &pool;
+        int number_of_threads;
+        size_t capacity, batch_size;
+        mutable std::mutex lock;
+        std::condition_variable room, idle;
+        std::map<std::tuple<int, index_type, index_type>, run*> waiting;     //runs not started yet, by what they compute
+        std::deque<std::unique_ptr<run> > ready;
+        size_t number_of_queries = 0;               //accepted and not answered yet
+        int active_tasks = 0;
+        std::vector<std::unique_ptr<workspace> > spare;
+        template<typename R>
+            query_future<R> submit(query_kind, index_type, index_type, index_type, std::vector<waiter<R> > run::*);
+        void run_batches();
+        void take_batch(std::vector<std::unique_ptr<run> >&);  //lock must be held
+        void answer(std::vector<std::unique_ptr<run> >&, workspace&);
+        void execute(run&, workspace&);
+        template<typename R>
+            bool search(const R&, run&, workspace&);   //false if it stopped because every query of the run was cancelled, R is adj or compressed
+    public:
+        query_engine(const graph_type&, std::function<T(edge_type)> get_weight = nullptr, const execution_policy& = {},
+                     size_t capacity = QUERY_ENGINE_CAPACITY, size_t batch_size = QUERY_ENGINE_BATCH);   //get_weight is needed on a weighted graph
+        query_engine(const query_engine&) = delete;
+        query_engine& operator=(const query_engine&) = delete;
+        ~query_engine();                            //waits until every query given to it is answered
+        query_future<bfs_result> bfs(const N&, index_type depth = std::numeric_limits<index_type>::max());  //as bfs_ids of the graph
+        query_future<path_result> single_source_shortest_path(const N&);   //as single_source_shortest_path_ids of the graph
+        query_future<path_result> shortest_path(const N&, const N&);        //the path from source to target, empty if there is none
+        query_future<bfs_result> bfs(const N&&, index_type depth = std::numeric_limits<index_type>::max()) = delete;     //labels are keyed by address, a temporary is never in the graph
+        query_future<path_result> single_source_shortest_path(const N&&) = delete;
+        query_future<path_result> shortest_path(const N&&, const N&) = delete;
+        query_future<path_result> shortest_path(const N&, const N&&) = delete;
+        query_future<path_result> shortest_path(const N&&, const N&&) = delete;
+        size_t pending() const;                     //queries accepted and not done with yet, counts towards capacity
+};
+
+
 
 
 
@@ -251,13 +1248,25 @@ class graph:
 #include "gmap.inc"
 #include "struct_traversal.inc"
 #include "struct_node_pair.inc"
+#include "parallel.inc"
 #include "disjoint_set_union.inc"
+#include "reachability_index.inc"
+#include "compressed_adjacency.inc"
+#include "link_cut_tree.inc"
+#include "adjacency_storage.inc"
+#include "traversal_range.inc"
 #include "get_data_type.inc"
 #include "Base.inc"
+#include "snapshot.inc"
+#include "edge_list_reader.inc"
 #include "Directed_Graph.inc"
 #include "Undirected_Graph.inc"
+#include "incremental_minimum_spanning_forest.inc"
+#include "external_graph.inc"
 #include "Unweighted_Graph.inc"
 #include "Weighted_Graph.inc"
 #include "graph.inc"
+#include "versioned_graph.inc"
+#include "query_engine.inc"
 
 #endif
\ No newline at end of file